@@ -0,0 +1,134 @@
+#!/usr/bin/env python
+
+#
+# motiontrace2bin.py -- converts BonnMotion and ns-2 motion traces into the
+# binary columnar trace format read by BonnMotionMobility/Ns2MotionMobility
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+
+"""
+Converts a motion trace into a binary file that BonnMotionFileCache maps
+into memory and shares between all nodes, without parsing it.
+
+Usage: motiontrace2bin.py [--ns2] <input trace> <output file>
+
+File layout (native byte order, all fields 8-byte aligned):
+
+    char[8]   magic "INETMTRC"
+    uint32    version (1)
+    uint32    format (0: BonnMotion, 1: ns-2)
+    uint32    byte order mark (0x01020304)
+    uint32    reserved (0)
+    uint64    number of lines N
+    uint64    offsets[N+1]  -- line i is values[offsets[i]:offsets[i+1]]
+    double    values[]
+
+For BonnMotion traces a line contains the numbers of the corresponding text
+line. For ns-2 traces line i describes $node_(i) as "x0 y0 z0" followed by
+one "t x y speed" quadruple per setdest command.
+"""
+
+import re
+import struct
+import sys
+
+MAGIC = b"INETMTRC"
+VERSION = 1
+FORMAT_BONNMOTION = 0
+FORMAT_NS2 = 1
+BYTE_ORDER_MARK = 0x01020304
+
+NUMBER = re.compile(r"[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?")
+
+
+def leading_numbers(text):
+    """Returns the numbers at the start of text, like repeated strtod() calls."""
+    values = []
+    pos = 0
+    while True:
+        while pos < len(text) and text[pos].isspace():
+            pos += 1
+        m = NUMBER.match(text, pos)
+        if not m:
+            return values
+        values.append(float(m.group(0)))
+        pos = m.end()
+
+
+def read_bonnmotion(f):
+    return [leading_numbers(line) for line in f]
+
+
+def read_ns2(f):
+    nodes = {}
+    for line in f:
+        line = line.rstrip("\r\n")
+        if line.startswith("#") or "$node_" not in line:
+            continue
+        pos1 = line.find("(")
+        pos2 = line.find(")")
+        if pos1 < 0 or pos2 < 0 or pos2 - pos1 <= 1:
+            continue
+        try:
+            node = int(line[pos1 + 1:pos2])
+        except ValueError:
+            continue
+        if node < 0:
+            continue
+        vec = nodes.setdefault(node, [-1.0, -1.0, -1.0])
+        if "setdest" in line:
+            at = line.find("at")
+            time = leading_numbers(line[at + 3:])
+            vec.append(time[0] if time else 0.0)
+            params = leading_numbers(line[line.find("setdest ") + 8:])[:3]
+            vec.extend(params + [0.0] * (3 - len(params)))
+        elif "set " in line:
+            for i, coord in enumerate(("X_", "Y_", "Z_")):
+                pos = line.find(coord)
+                if pos >= 0:
+                    value = leading_numbers(line[pos + 3:])
+                    vec[i] = value[0] if value else 0.0
+    if not nodes:
+        return []
+    return [nodes.get(i, []) for i in range(max(nodes) + 1)]
+
+
+def write_binary(lines, fmt, out):
+    offsets = [0]
+    for line in lines:
+        offsets.append(offsets[-1] + len(line))
+    out.write(MAGIC)
+    out.write(struct.pack("=IIIIQ", VERSION, fmt, BYTE_ORDER_MARK, 0, len(lines)))
+    out.write(struct.pack("=%dQ" % len(offsets), *offsets))
+    for line in lines:
+        if line:
+            out.write(struct.pack("=%dd" % len(line), *line))
+
+
+def main(argv):
+    args = argv[1:]
+    fmt = FORMAT_BONNMOTION
+    if args and args[0] == "--ns2":
+        fmt = FORMAT_NS2
+        args = args[1:]
+    if len(args) != 2:
+        sys.stderr.write(__doc__)
+        return 1
+    with open(args[0]) as f:
+        lines = read_ns2(f) if fmt == FORMAT_NS2 else read_bonnmotion(f)
+    with open(args[1], "wb") as out:
+        write_binary(lines, fmt, out)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -326,7 +326,9 @@ void HttpBrowserBase::handleDataMessage(cMessage *msg)
         {
             case CT_HTML:
                 EV_INFO << "HTML Document received: " << appmsg->getName() << "'. Size is " << appmsg->getByteLength() << " bytes and serial " << serial << endl;
-                if (strlen(appmsg->payload()) != 0)
+                if (!appmsg->page().isNull() && appmsg->page()->getNumResources() != 0)
+                    EV_DEBUG << appmsg->getName() << " references " << appmsg->page()->getNumResources() << " resources" << endl;
+                else if (strlen(appmsg->payload()) != 0)
                     EV_DEBUG << "Payload of " << appmsg->getName() << " is: " << endl << appmsg->payload()
                              << ", " << strlen(appmsg->payload()) << " bytes" << endl;
                 else
@@ -354,62 +356,35 @@ void HttpBrowserBase::handleDataMessage(cMessage *msg)
                 break;
         }
 
-        // Parse the html page body
-        if ((HttpContentType)appmsg->contentType() == CT_HTML && strlen(appmsg->payload()) != 0)
+        // Issue the requests for the resources referenced by the html page. Replies from servers
+        // which still send a text body instead of a page descriptor are parsed here.
+        HttpPageDescriptorPtr page = appmsg->page();
+        if ((HttpContentType)appmsg->contentType() == CT_HTML && page.isNull() && strlen(appmsg->payload()) != 0)
+            page = HttpPageDescriptor::parse(appmsg->payload());
+        if ((HttpContentType)appmsg->contentType() == CT_HTML && !page.isNull() && page->getNumResources() != 0)
         {
             EV_DEBUG << "Processing HTML document body:\n";
-            cStringTokenizer lineTokenizer((const char*)appmsg->payload(), "\n");
-            std::vector<std::string> lines = lineTokenizer.asVector();
             int serial = 0;
-            std::string providerName = "";
-            std::string resourceName = "";
-            double delay = 0.0;
-            bool bad = false;
-            int refSize = 0;
             HttpRequestQueue queue;
             std::map<std::string,HttpRequestQueue> requestQueues;
-            for (std::vector<std::string>::iterator iter = lines.begin(); iter != lines.end(); iter++)
+            for (unsigned int i = 0; i < page->getNumResources(); i++)
             {
-                std::string resourceLine = *iter;
-                cStringTokenizer fieldTokenizer(resourceLine.c_str(), ";");
-                std::vector<std::string> fields = fieldTokenizer.asVector();
-                if (fields.size()<1)
-                {
-                    EV_ERROR << "Invalid resource reference in received message: " << resourceLine << endl;
-                    continue;
-                }
-                // Get the resource name -- this is mandatory for all references
-                resourceName = fields[0];
-
-                providerName = senderWWW;
-                if (fields.size()>1)
-                    providerName = fields[1];
-
-                delay = 0.0;
-                if (fields.size()>2)
-                    delay = safeatof(fields[2].c_str());
-
-                bad = false;
-                if (fields.size()>3)
-                    bad = safeatobool(fields[3].c_str());
-
-                refSize = 0;
-                if (fields.size()>4)
-                    refSize = safeatoi(fields[4].c_str());
+                const HttpResourceRef& resource = page->getResource(i);
+                const std::string& providerName = resource.provider.empty() ? senderWWW : resource.provider;
 
-                EV_DEBUG << "Generating resource request: " << resourceName << ". Provider: " << providerName
-                         << ", delay: " << delay << ", bad: " << bad << ", ref.size: " << refSize <<endl;
+                EV_DEBUG << "Generating resource request: " << resource.name << ". Provider: " << providerName
+                         << ", delay: " << resource.delay << ", bad: " << resource.bad << ", ref.size: " << resource.refSize <<endl;
 
                 // Generate a request message and push on queue for the intended recipient
-                HttpRequestMessage *reqmsg = generateResourceRequest(providerName, resourceName, serial++, bad, refSize); // TODO: KVJ: CHECK HERE FOR XSITE
-                if (delay==0.0)
+                HttpRequestMessage *reqmsg = generateResourceRequest(providerName, resource.name, serial++, resource.bad, resource.refSize); // TODO: KVJ: CHECK HERE FOR XSITE
+                if (resource.delay==0.0)
                 {
                     requestQueues[providerName].push_front(reqmsg);
                 }
                 else
                 {
                     reqmsg->setKind(HTTPT_DELAYED_REQUEST_MESSAGE);
-                    scheduleAt(simTime()+delay, reqmsg);             // Schedule the message as a self message
+                    scheduleAt(simTime()+resource.delay, reqmsg);             // Schedule the message as a self message
                 }
             }
             // Iterate through the list of queues (one for each recipient encountered) and submit each queue.
@@ -195,7 +195,10 @@ std::string HttpNodeBase::formatHttpResponseLong(const HttpReplyMessage* httpRes
     if (m_bDisplayResponseContent)
     {
         str << "CONTENT:" << endl;
-        str << httpResponse->payload() << endl;
+        if (!httpResponse->page().isNull())
+            str << httpResponse->page()->str() << endl;
+        else
+            str << httpResponse->payload() << endl;
     }
 
     return str.str();
@@ -0,0 +1,84 @@
+// ***************************************************************************
+//
+// HttpTools Project
+//
+// This file is a part of the HttpTools project. The project was created at
+// Reykjavik University, the Laboratory for Dependable Secure Systems (LDSS).
+// Its purpose is to create a set of OMNeT++ components to simulate browsing
+// behaviour in a high-fidelity manner along with a highly configurable
+// Web server component.
+//
+// Maintainer: Kristjan V. Jonsson (LDSS) kristjanvj@gmail.com
+// Project home page: code.google.com/p/omnet-httptools
+//
+// ***************************************************************************
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License version 3
+// as published by the Free Software Foundation.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+//
+// ***************************************************************************
+
+#include "HttpPageDescriptor.h"
+
+#include "HttpUtils.h"
+
+
+void HttpPageDescriptor::addResource(const std::string& name)
+{
+    HttpResourceRef resource;
+    resource.name = name;
+    resources.push_back(resource);
+}
+
+std::string HttpPageDescriptor::str() const
+{
+    std::ostringstream os;
+    for (std::vector<HttpResourceRef>::const_iterator it = resources.begin(); it != resources.end(); ++it)
+    {
+        os << it->name;
+        if (!it->provider.empty())
+            os << ";" << it->provider << ";" << it->delay << ";" << (it->bad ? "TRUE" : "FALSE") << ";" << it->refSize;
+        os << "\n";
+    }
+    return os.str();
+}
+
+HttpPageDescriptor *HttpPageDescriptor::parse(const char *body)
+{
+    HttpPageDescriptor *page = new HttpPageDescriptor();
+    cStringTokenizer lineTokenizer(body, "\n");
+    while (lineTokenizer.hasMoreTokens())
+    {
+        const char *resourceLine = lineTokenizer.nextToken();
+        cStringTokenizer fieldTokenizer(resourceLine, ";");
+        std::vector<std::string> fields = fieldTokenizer.asVector();
+        if (fields.size()<1)
+        {
+            EV_ERROR << "Invalid resource reference in page body: " << resourceLine << endl;
+            continue;
+        }
+
+        HttpResourceRef resource;
+        resource.name = fields[0];  // the resource name is mandatory for all references
+        if (fields.size()>1)
+            resource.provider = fields[1];
+        if (fields.size()>2)
+            resource.delay = safeatof(fields[2].c_str());
+        if (fields.size()>3)
+            resource.bad = safeatobool(fields[3].c_str());
+        if (fields.size()>4)
+            resource.refSize = safeatoi(fields[4].c_str());
+        page->resources.push_back(resource);
+    }
+    return page;
+}
@@ -0,0 +1,148 @@
+// ***************************************************************************
+//
+// HttpTools Project
+//
+// This file is a part of the HttpTools project. The project was created at
+// Reykjavik University, the Laboratory for Dependable Secure Systems (LDSS).
+// Its purpose is to create a set of OMNeT++ components to simulate browsing
+// behaviour in a high-fidelity manner along with a highly configurable
+// Web server component.
+//
+// Maintainer: Kristjan V. Jonsson (LDSS) kristjanvj@gmail.com
+// Project home page: code.google.com/p/omnet-httptools
+//
+// ***************************************************************************
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License version 3
+// as published by the Free Software Foundation.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+//
+// ***************************************************************************
+
+#ifndef __INET_HTTPPAGEDESCRIPTOR_H
+#define __INET_HTTPPAGEDESCRIPTOR_H
+
+#include <vector>
+#include <string>
+
+#include "INETDefs.h"
+
+
+/**
+ * A resource referenced by a HTML page, i.e. one line of the page body
+ * in the text form <tt>{resource}[;{site};{delay};{bad};{refSize}]</tt>.
+ */
+struct HttpResourceRef
+{
+    std::string name;       ///< The resource, e.g. IMG0001.jpg
+    std::string provider;   ///< The site hosting the resource; empty for the site serving the page
+    double delay;           ///< Delay before the browser requests the resource
+    bool bad;               ///< Request the resource as a bad request (answered by 404)
+    int refSize;            ///< Extra bytes added to the size of the request
+
+    HttpResourceRef() : delay(0.0), bad(false), refSize(0) {}
+};
+
+/**
+ * Structured body of a HTML page: the list of resources the browser has to
+ * request after receiving the page.
+ *
+ * Servers attach descriptors to replies instead of generating a text body
+ * which the browser would have to parse again. A descriptor must not be
+ * modified once it is referenced by a message; identical pages (e.g. the
+ * pages of a site definition file, or random pages with the same number of
+ * images and text resources) share one descriptor. Descriptors are reference
+ * counted through HttpPageDescriptorPtr and are deleted with the last reference.
+ *
+ * The text form is still used by site definition files, and can be
+ * converted with parse() and str().
+ */
+class INET_API HttpPageDescriptor
+{
+  protected:
+    std::vector<HttpResourceRef> resources;
+    mutable int refCount;
+
+  private:
+    // not copyable: shared by reference
+    HttpPageDescriptor(const HttpPageDescriptor&);
+    HttpPageDescriptor& operator=(const HttpPageDescriptor&);
+
+  public:
+    HttpPageDescriptor() : refCount(0) {}
+    virtual ~HttpPageDescriptor() {}
+
+    /** Appends a resource reference; only allowed while the descriptor is not shared */
+    void addResource(const HttpResourceRef& resource) { resources.push_back(resource); }
+
+    /** Appends a reference to a resource of the site serving the page */
+    void addResource(const std::string& name);
+
+    unsigned int getNumResources() const { return resources.size(); }
+    const HttpResourceRef& getResource(unsigned int i) const { return resources.at(i); }
+
+    /**
+     * Returns the page body in text form, one resource per line. Meant for
+     * logging; references to resources of other sites are written with all
+     * fields, local ones with the name only.
+     */
+    std::string str() const;
+
+    /**
+     * Creates a descriptor from the text form of a page body, with the
+     * same rules the browser used for parsing received page bodies.
+     */
+    static HttpPageDescriptor *parse(const char *body);
+
+    /** @name Reference counting, see HttpPageDescriptorPtr */
+    //@{
+    void retain() const { refCount++; }
+    void release() const { if (--refCount == 0) delete this; }
+    //@}
+};
+
+/**
+ * Reference counting pointer to an immutable HttpPageDescriptor; used as
+ * field type in HttpReplyMessage, so that duplicating a reply does not copy
+ * the page.
+ */
+class INET_API HttpPageDescriptorPtr
+{
+  protected:
+    const HttpPageDescriptor *page;
+
+  public:
+    HttpPageDescriptorPtr() : page(NULL) {}
+    HttpPageDescriptorPtr(const HttpPageDescriptor *page) : page(page) { if (page) page->retain(); }
+    HttpPageDescriptorPtr(const HttpPageDescriptorPtr& other) : page(other.page) { if (page) page->retain(); }
+    ~HttpPageDescriptorPtr() { if (page) page->release(); }
+
+    HttpPageDescriptorPtr& operator=(const HttpPageDescriptorPtr& other) {
+        if (other.page) other.page->retain();
+        if (page) page->release();
+        page = other.page;
+        return *this;
+    }
+
+    const HttpPageDescriptor *get() const { return page; }
+    const HttpPageDescriptor *operator->() const { return page; }
+    bool isNull() const { return page == NULL; }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const HttpPageDescriptorPtr& page)
+{
+    if (page.isNull())
+        return os << "(none)";
+    return os << page->getNumResources() << " resources";
+}
+
+#endif
@@ -328,12 +328,12 @@ HttpReplyMessage* HttpServerBase::generateDocument(HttpRequestMessage *request,
 
     if (scriptedMode)
     {
-        replymsg->setPayload(htmlPages[resource].body.c_str());
+        replymsg->setPage(htmlPages[resource].page);
         size = htmlPages[resource].size;
     }
     else
     {
-        replymsg->setPayload(generateBody().c_str());
+        replymsg->setPage(generatePage());
     }
 
     if (size==0)
@@ -404,27 +404,31 @@ HttpReplyMessage* HttpServerBase::generateErrorReply(HttpRequestMessage *request
     return replymsg;
 }
 
-std::string HttpServerBase::generateBody()
+HttpPageDescriptorPtr HttpServerBase::generatePage()
 {
     int numResources = (int)rdNumResources->draw();
     int numImages = (int)(numResources*rdTextImageResourceRatio->draw());
     int numText = numResources - numImages;
 
-    std::string result;
-
-    char tempBuf[128];
-    for (int i=0; i<numImages; i++)
-    {
-        sprintf(tempBuf, "%s%.4d.%s\n", "IMG", i, "jpg");
-        result.append(tempBuf);
-    }
-    for (int i=0; i<numText; i++)
+    // Pages with the same number of images and text resources are identical
+    HttpPageDescriptorPtr& page = randomPages[std::make_pair(numImages, numText)];
+    if (page.isNull())
     {
-        sprintf(tempBuf, "%s%.4d.%s\n", "TEXT", i, "txt");
-        result.append(tempBuf);
+        HttpPageDescriptor *newPage = new HttpPageDescriptor();
+        char tempBuf[128];
+        for (int i=0; i<numImages; i++)
+        {
+            sprintf(tempBuf, "%s%.4d.%s", "IMG", i, "jpg");
+            newPage->addResource(tempBuf);
+        }
+        for (int i=0; i<numText; i++)
+        {
+            sprintf(tempBuf, "%s%.4d.%s", "TEXT", i, "txt");
+            newPage->addResource(tempBuf);
+        }
+        page = newPage;
     }
-
-    return result;
+    return page;
 }
 
 void HttpServerBase::registerWithController()
@@ -508,6 +512,7 @@ void HttpServerBase::readSiteDefinition(std::string file)
                 EV_DEBUG << "Adding html page definition " << key << ". The page size is " << size << endl;
                 htmlPages[key].size = size;
                 htmlPages[key].body = body;
+                htmlPages[key].page = HttpPageDescriptor::parse(body.c_str());
             }
             else if (resourceSection)
             {
@@ -67,7 +67,8 @@ class INET_API HttpServerBase : public HttpNodeBase
         struct HtmlPageData
         {
             long size;
-            std::string body;
+            std::string body;           ///< The page body as read from the page definition file
+            HttpPageDescriptorPtr page; ///< The body parsed once, attached to every reply
         };
 
         /** The server name, e.g. www.example.com. */
@@ -81,6 +82,8 @@ class INET_API HttpServerBase : public HttpNodeBase
         std::map<std::string,HtmlPageData> htmlPages;
         /** A map of resource, keyed by a resource URL. Used in scripted mode. */
         std::map<std::string,unsigned int> resources;
+        /** Random pages generated so far, keyed by the number of images and text resources. */
+        std::map<std::pair<int,int>,HttpPageDescriptorPtr> randomPages;
 
         // Basic statistics
         long htmlDocsServed;
@@ -132,8 +135,8 @@ class INET_API HttpServerBase : public HttpNodeBase
         HttpReplyMessage* handleGetRequest(HttpRequestMessage *request, std::string resource);
         /** Generate a error reply in case of invalid resource requests. */
         HttpReplyMessage* generateErrorReply(HttpRequestMessage *request, int code);
-        /** Create a random body according to the site content random distributions. */
-        virtual std::string generateBody();
+        /** Create a random page according to the site content random distributions. */
+        virtual HttpPageDescriptorPtr generatePage();
 
         /** Handle a received data message, e.g. check if the content requested exists. */
         cPacket* handleReceivedMessage(cMessage *msg);
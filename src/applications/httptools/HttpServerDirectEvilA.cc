@@ -46,21 +46,23 @@ void HttpServerDirectEvilA::initialize(int stage)
     }
 }
 
-std::string HttpServerDirectEvilA::generateBody()
+HttpPageDescriptorPtr HttpServerDirectEvilA::generatePage()
 {
     int numImages = badLow+(int)uniform(0, badHigh-badLow);
-    double rndDelay;
-    std::string result;
+    HttpPageDescriptor *page = new HttpPageDescriptor();
 
     char tempBuf[128];
     for (int i=0; i<numImages; i++)
     {
-        rndDelay = 10.0+uniform(0, 2.0);
-        sprintf(tempBuf, "IMG%.4d.jpg;%s;%f\n", i, "www.good.com", rndDelay);
-        result.append(tempBuf);
+        sprintf(tempBuf, "IMG%.4d.jpg", i);
+        HttpResourceRef resource;
+        resource.name = tempBuf;
+        resource.provider = "www.good.com";
+        resource.delay = roundToTextPrecision(10.0+uniform(0, 2.0)); // as in the former text page
+        page->addResource(resource);
     }
 
-    return result;
+    return page;
 }
 
 
@@ -41,7 +41,7 @@
  * which serves HTML pages containing attack code. In this case, we are simulating JavaScript attack code which prompts
  * the unsuspecting browser to issue a number of requests for non-existing resources to the victim site.
  * Delays are specified to simulate hiding the attack from the browser user by use of JavaScript timeouts or similar mechanisms.
- * The generateBody virtual function is redefined to create a page containing the attack code.
+ * The generatePage virtual function is redefined to create a page containing the attack code.
  *
  * @see HttpServerDirect
  *
@@ -56,7 +56,7 @@ class INET_API HttpServerDirectEvilA : public HttpServerDirect
     protected:
         virtual int numInitStages() const { return 4; }
         virtual void initialize(int stage);
-        virtual std::string generateBody();
+        virtual HttpPageDescriptorPtr generatePage();
 };
 
 #endif /* HttpServerDirectEvilA */
@@ -48,22 +48,24 @@ void HttpServerDirectEvilB::initialize(int stage)
     }
 }
 
-std::string HttpServerDirectEvilB::generateBody()
+HttpPageDescriptorPtr HttpServerDirectEvilB::generatePage()
 {
     int numResources = badLow+(int)uniform(0, badHigh-badLow);
-    double rndDelay;
-    std::string result;
+    HttpPageDescriptor *page = new HttpPageDescriptor();
 
     char tempBuf[128];
-    int refSize;
     for (int i=0; i<numResources; i++)
     {
-        rndDelay = 10.0+uniform(0, 2.0);
-        refSize = (int)uniform(500, 1000); // The random size represents a random reference string length
-        sprintf(tempBuf, "TEXT%.4d.txt;%s;%f;%s;%d\n", i, "www.good.com", rndDelay, "TRUE", refSize);
-        result.append(tempBuf);
+        sprintf(tempBuf, "TEXT%.4d.txt", i);
+        HttpResourceRef resource;
+        resource.name = tempBuf;
+        resource.provider = "www.good.com";
+        resource.delay = roundToTextPrecision(10.0+uniform(0, 2.0)); // as in the former text page
+        resource.bad = true;
+        resource.refSize = (int)uniform(500, 1000); // The random size represents a random reference string length
+        page->addResource(resource);
     }
 
-    return result;
+    return page;
 }
 
@@ -29,6 +29,7 @@
 
 #include <algorithm>
 #include <ctype.h>
+#include <stdio.h>
 
 #include "HttpUtils.h"
 
@@ -221,6 +222,14 @@ int safeatobool(const char* strval, bool defaultVal)
     }
 }
 
+// rounds to six decimals, like printing with %f into a page body and parsing it back
+double roundToTextPrecision(double value)
+{
+    char buf[512];
+    sprintf(buf, "%f", value);
+    return safeatof(buf);
+}
+
 std::vector<std::string> splitFile(std::string fileName)
 {
     std::string path = "";
@@ -62,6 +62,7 @@ std::string htmlErrFromCode(int code);
 double safeatof(const char* strval, double defaultVal = 0.0);
 int safeatoi(const char* strval, int defaultVal = 0);
 int safeatobool(const char* strval, bool defaultVal = false);
+double roundToTextPrecision(double value);
 std::vector<std::string> splitFile(std::string fileName);
 
 #endif
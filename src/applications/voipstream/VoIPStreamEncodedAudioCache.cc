@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "VoIPStreamEncodedAudioCache.h"
+
+
+VoIPStreamEncodedAudioCache *VoIPStreamEncodedAudioCache::inst;
+int VoIPStreamEncodedAudioCache::refCount;
+
+VoIPStreamEncodedAudioCache *VoIPStreamEncodedAudioCache::acquireInstance()
+{
+    if (!inst)
+        inst = new VoIPStreamEncodedAudioCache;
+    refCount++;
+    return inst;
+}
+
+void VoIPStreamEncodedAudioCache::releaseInstance()
+{
+    ASSERT(inst && refCount > 0);
+    if (--refCount == 0)
+    {
+        delete inst;
+        inst = NULL;
+    }
+}
+
+VoIPStreamEncodedAudioCache::~VoIPStreamEncodedAudioCache()
+{
+    for (AudioMap::iterator it = cache.begin(); it != cache.end(); ++it)
+        delete it->second;
+}
+
+const VoIPStreamEncodedAudio *VoIPStreamEncodedAudioCache::find(const std::string& key) const
+{
+    AudioMap::const_iterator it = cache.find(key);
+    return it == cache.end() ? NULL : it->second;
+}
+
+void VoIPStreamEncodedAudioCache::add(const std::string& key, const VoIPStreamEncodedAudio *audio)
+{
+    ASSERT(cache.find(key) == cache.end());
+    cache[key] = audio;
+}
@@ -0,0 +1,95 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef VOIPSTREAM_VOIPSTREAMENCODEDAUDIOCACHE_H
+#define VOIPSTREAM_VOIPSTREAMENCODEDAUDIOCACHE_H
+
+#include <vector>
+
+#include "INETDefs.h"
+
+/**
+ * One pass of a sound file, resampled, chopped into packets and encoded.
+ * Immutable once it has been added to the cache.
+ */
+class INET_API VoIPStreamEncodedAudio
+{
+  public:
+    struct Frame
+    {
+        std::vector<uint8_t> data;  // encoded payload
+        bool isSilent;
+    };
+
+    int codec;                      // FFmpeg identifier of the codec
+    short sampleBits;
+    std::vector<Frame> frames;
+
+  public:
+    VoIPStreamEncodedAudio() : codec(0), sampleBits(0) {}
+};
+
+/**
+ * Shared object that stores encoded sound files, so that VoIPStreamSender
+ * modules that send the same file with the same encoding parameters run the
+ * decoder, the resampler and the encoder only once per simulation run.
+ *
+ * The instance is reference counted: every sender that uses it calls
+ * acquireInstance() once and releaseInstance() in its destructor, and the
+ * cache is deleted with the last sender. Deleting one sender at runtime
+ * therefore leaves the frames of the others intact.
+ *
+ * The key must contain every parameter that influences the encoded frames
+ * (file name, codec, bit rate, sample rate, packet length, silence threshold).
+ */
+class INET_API VoIPStreamEncodedAudioCache
+{
+  protected:
+    typedef std::map<std::string, const VoIPStreamEncodedAudio *> AudioMap;
+    AudioMap cache;
+    static VoIPStreamEncodedAudioCache *inst;
+    static int refCount;
+
+    VoIPStreamEncodedAudioCache() {}
+    virtual ~VoIPStreamEncodedAudioCache();
+
+  public:
+    /**
+     * Returns the shared instance, creating it if needed, and increments
+     * its reference count.
+     */
+    static VoIPStreamEncodedAudioCache *acquireInstance();
+
+    /**
+     * Decrements the reference count, and deletes the shared instance
+     * with all stored audio when it drops to zero.
+     */
+    static void releaseInstance();
+
+    /**
+     * Returns the encoded audio stored with the given key, or NULL.
+     */
+    virtual const VoIPStreamEncodedAudio *find(const std::string& key) const;
+
+    /**
+     * Stores the encoded audio with the given key; the cache takes ownership.
+     */
+    virtual void add(const std::string& key, const VoIPStreamEncodedAudio *audio);
+};
+
+#endif // VOIPSTREAM_VOIPSTREAMENCODEDAUDIOCACHE_H
@@ -33,6 +33,8 @@ simsignal_t VoIPStreamReceiver::dropPkSignal = registerSignal("dropPk");
 simsignal_t VoIPStreamReceiver::packetHasVoiceSignal = registerSignal("packetHasVoice");
 simsignal_t VoIPStreamReceiver::connStateSignal = registerSignal("connState");
 simsignal_t VoIPStreamReceiver::delaySignal = registerSignal("delay");
+simsignal_t VoIPStreamReceiver::jitterSignal = registerSignal("jitter");
+simsignal_t VoIPStreamReceiver::mosSignal = registerSignal("mos");
 
 VoIPStreamReceiver::~VoIPStreamReceiver()
 {
@@ -55,6 +57,7 @@ void VoIPStreamReceiver::initialize(int stage)
         localPort = par("localPort");
         resultFile = par("resultFile");
         playoutDelay = par("playoutDelay");
+        decodeAudio = par("decodeAudio");
 
         // initialize avcodec library
         av_register_all();
@@ -119,6 +122,19 @@ void VoIPStreamReceiver::Connection::writeLostSamples(int sampleCount)
 
 void VoIPStreamReceiver::Connection::writeAudioFrame(uint8_t *inbuf, int inbytes)
 {
+    if (!decodeAudio)
+    {
+        // constant bit rate codecs: the duration follows from the payload size
+        int samples = 0;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(54,28,0)
+        samples = av_get_audio_frame_duration(decCtx, inbytes);
+#endif
+        if (samples <= 0)
+            samples = samplesPerPacket;
+        lastPacketFinish += simtime_t(1.0 * samples / sampleRate);
+        return;
+    }
+
     AVPacket avpkt;
     av_init_packet(&avpkt);
     avpkt.data = inbuf;
@@ -161,6 +177,12 @@ void VoIPStreamReceiver::createConnection(VoIPStreamPacket *vp)
     curConn.transmitBitrate = vp->getTransmitBitrate();
     curConn.samplesPerPacket = vp->getSamplesPerPacket();
     curConn.lastPacketFinish = simTime() + playoutDelay;
+    curConn.decodeAudio = decodeAudio;
+    curConn.numReceivedPackets = 0;
+    curConn.numLostPackets = 0;
+    curConn.sumDelay = 0;
+    curConn.lastTransit = SIMTIME_ZERO;
+    curConn.jitter = 0;
 
     curConn.pCodecDec = avcodec_find_decoder(curConn.codec);
     if (curConn.pCodecDec == NULL)
@@ -172,11 +194,14 @@ void VoIPStreamReceiver::createConnection(VoIPStreamPacket *vp)
     curConn.decCtx->channels = 1;
     curConn.decCtx->bits_per_coded_sample = curConn.sampleBits;
 
-    int ret = avcodec_open2(curConn.decCtx, curConn.pCodecDec, NULL);
-    if (ret < 0)
-        throw cRuntimeError("could not open decoding codec %d (%s): err=%d", curConn.codec, curConn.pCodecDec->name, ret);
+    if (decodeAudio)
+    {
+        int ret = avcodec_open2(curConn.decCtx, curConn.pCodecDec, NULL);
+        if (ret < 0)
+            throw cRuntimeError("could not open decoding codec %d (%s): err=%d", curConn.codec, curConn.pCodecDec->name, ret);
 
-    curConn.openAudio(resultFile);
+        curConn.openAudio(resultFile);
+    }
     curConn.offline = false;
     emit(connStateSignal, 1);
 }
@@ -207,6 +232,9 @@ void VoIPStreamReceiver::closeConnection()
     if (!curConn.offline)
     {
         curConn.offline = true;
+        long numPackets = curConn.numReceivedPackets + curConn.numLostPackets;
+        if (curConn.numReceivedPackets > 0)
+            emit(mosSignal, computeMOS((double)curConn.numLostPackets / numPackets, curConn.sumDelay / curConn.numReceivedPackets));
         avcodec_close(curConn.decCtx);
         curConn.outFile.close();
         emit(connStateSignal, -1L); // so that sum() yields the number of active sessions
@@ -223,7 +251,21 @@ void VoIPStreamReceiver::decodePacket(VoIPStreamPacket *vp)
     }
     uint16_t newSeqNo = vp->getSeqNo();
     if (newSeqNo > curConn.seqNo + 1)
+    {
         emit(lostPacketsSignal, newSeqNo - (curConn.seqNo + 1));
+        curConn.numLostPackets += newSeqNo - (curConn.seqNo + 1);
+    }
+
+    // interarrival jitter as defined in RFC 3550, section 6.4.1
+    simtime_t transit = simTime() - vp->getCreationTime();
+    if (curConn.numReceivedPackets > 0)
+    {
+        double d = fabs(SIMTIME_DBL(transit - curConn.lastTransit));
+        curConn.jitter += (d - curConn.jitter) / 16;
+        emit(jitterSignal, curConn.jitter);
+    }
+    curConn.lastTransit = transit;
+    curConn.numReceivedPackets++;
 
     // for fingerprint
     cHasher *hasher = simulation.getHasher();
@@ -240,6 +282,7 @@ void VoIPStreamReceiver::decodePacket(VoIPStreamPacket *vp)
             hasher->add(lostSamples);
     }
     emit(delaySignal, curConn.lastPacketFinish - vp->getCreationTime());
+    curConn.sumDelay += SIMTIME_DBL(curConn.lastPacketFinish - vp->getCreationTime());
     curConn.seqNo = newSeqNo;
 
     int len = vp->getByteArray().getDataArraySize();
@@ -250,6 +293,23 @@ void VoIPStreamReceiver::decodePacket(VoIPStreamPacket *vp)
         hasher->add((const char *)buff, len);
 }
 
+double VoIPStreamReceiver::computeMOS(double lossRatio, double delay)
+{
+    // simplified ITU-T G.107 E-model with default values except delay and loss;
+    // the codec is assumed to have no intrinsic impairment (Ie = 0) and no
+    // packet loss concealment (Bpl = 4.3, the G.113 value for G.711)
+    double d = delay * 1000;
+    double Id = 0.024 * d + (d > 177.3 ? 0.11 * (d - 177.3) : 0);
+    double Ppl = lossRatio * 100;
+    double IeEff = 95 * Ppl / (Ppl + 4.3);
+    double R = 93.2 - Id - IeEff;
+    if (R <= 0)
+        return 1;
+    if (R >= 100)
+        return 4.5;
+    return 1 + 0.035 * R + R * (R - 60) * (100 - R) * 7e-6;
+}
+
 void VoIPStreamReceiver::finish()
 {
     EV_TRACE << "Sink finish()" << endl;
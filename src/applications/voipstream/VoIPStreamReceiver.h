@@ -64,11 +64,12 @@ class VoIPStreamReceiver : public cSimpleModule, public ILifecycle
     virtual void checkSourceAndParameters(VoIPStreamPacket *vp);
     virtual void closeConnection();
     virtual void decodePacket(VoIPStreamPacket *vp);
+    virtual double computeMOS(double lossRatio, double delay);
 
     class Connection
     {
       public:
-        Connection() : offline(true), oc(NULL), fmt(NULL), audio_st(NULL), decCtx(NULL), pCodecDec(NULL) {}
+        Connection() : offline(true), decodeAudio(true), oc(NULL), fmt(NULL), audio_st(NULL), decCtx(NULL), pCodecDec(NULL) {}
         void addAudioStream(enum CodecID codec_id);
         void openAudio(const char *fileName);
         void writeAudioFrame(uint8_t *buf, int len);
@@ -76,6 +77,7 @@ class VoIPStreamReceiver : public cSimpleModule, public ILifecycle
         void closeAudio();
 
         bool offline;
+        bool decodeAudio;
         uint16_t seqNo;
         uint32_t timeStamp;
         uint32_t ssrc;
@@ -95,12 +97,20 @@ class VoIPStreamReceiver : public cSimpleModule, public ILifecycle
         int srcPort;
         IPvXAddress destAddr;
         int destPort;
+
+        // statistics
+        long numReceivedPackets;
+        long numLostPackets;
+        double sumDelay;
+        simtime_t lastTransit;
+        double jitter;
     };
 
   protected:
     int localPort;
     simtime_t playoutDelay;
     const char *resultFile;
+    bool decodeAudio;
 
     UDPSocket socket;
 
@@ -113,6 +123,8 @@ class VoIPStreamReceiver : public cSimpleModule, public ILifecycle
     static simsignal_t packetHasVoiceSignal;
     static simsignal_t connStateSignal;
     static simsignal_t delaySignal;
+    static simsignal_t jitterSignal;
+    static simsignal_t mosSignal;
 };
 
 #endif // VOIPSTREAM_VOIPSTREAMRECEIVER_H
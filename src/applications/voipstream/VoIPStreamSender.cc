@@ -43,11 +43,16 @@ VoIPStreamSender::VoIPStreamSender()
     pEncoderCtx = NULL;
     pCodecEncoder = NULL;
     timer = NULL;
+    audioCache = NULL;
+    encodedAudio = NULL;
+    encodedFrameIndex = 0;
 }
 
 VoIPStreamSender::~VoIPStreamSender()
 {
     cancelAndDelete(timer);
+    if (audioCache)
+        VoIPStreamEncodedAudioCache::releaseInstance();
 }
 
 VoIPStreamSender::Buffer::Buffer() :
@@ -93,6 +98,7 @@ void VoIPStreamSender::initialize(int stage)
         soundFile = par("soundFile").stringValue();
         repeatCount = par("repeatCount");
         traceFileName = par("traceFileName").stringValue();
+        shareEncodedAudio = par("shareEncodedAudio");
 
         pReSampleCtx = NULL;
         localPort = par("localPort");
@@ -126,7 +132,11 @@ void VoIPStreamSender::initialize(int stage)
 
         av_init_packet(&packet);
 
-        openSoundFile(soundFile);
+        // the trace file records the input samples, so that needs the sender's own encoder
+        if (shareEncodedAudio && !(traceFileName && *traceFileName))
+            encodeSoundFile();
+        else
+            openSoundFile(soundFile);
 
         timer = new cMessage("sendVoIP");
         scheduleAt(startTime, timer);
@@ -153,7 +163,7 @@ void VoIPStreamSender::handleMessage(cMessage *msg)
                 if (repeatCount > 1)
                 {
                     repeatCount--;
-                    av_seek_frame(pFormatCtx, streamIndex, 0, 0);
+                    rewindSoundFile();
                     packet = generatePacket();
                 }
             }
@@ -180,7 +190,11 @@ void VoIPStreamSender::finish()
 {
     av_free_packet(&packet);
     outFile.close();
+    closeSoundFile();
+}
 
+void VoIPStreamSender::closeSoundFile()
+{
     if (pReSampleCtx)
     {
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(54,28,0)
@@ -192,10 +206,61 @@ void VoIPStreamSender::finish()
         pReSampleCtx = NULL;
     }
 
+    if (pEncoderCtx)
+    {
+        avcodec_close(pEncoderCtx);
+        av_free(pEncoderCtx);
+        pEncoderCtx = NULL;
+    }
+
+    if (pCodecCtx)
+    {
+        avcodec_close(pCodecCtx);
+        pCodecCtx = NULL;
+    }
+
     if (this->pFormatCtx)
         avformat_close_input(&pFormatCtx);
 }
 
+void VoIPStreamSender::rewindSoundFile()
+{
+    if (encodedAudio)
+        encodedFrameIndex = 0;
+    else
+        av_seek_frame(pFormatCtx, streamIndex, 0, 0);
+}
+
+void VoIPStreamSender::encodeSoundFile()
+{
+    std::ostringstream key;
+    key << soundFile << '|' << codec << '|' << compressedBitRate << '|' << sampleRate << '|'
+        << samplesPerPacket << '|' << voipSilenceThreshold;
+
+    ASSERT(!audioCache);
+    audioCache = VoIPStreamEncodedAudioCache::acquireInstance();
+    encodedAudio = audioCache->find(key.str());
+    encodedFrameIndex = 0;
+    if (encodedAudio)
+    {
+        EV_INFO << "Using the cached encoding of sound file '" << soundFile << "'" << endl;
+        return;
+    }
+
+    // encode one pass of the file; senders with the same key replay the frames
+    openSoundFile(soundFile);
+    VoIPStreamEncodedAudio *audio = new VoIPStreamEncodedAudio();
+    audio->codec = pEncoderCtx->codec_id;
+    audio->sampleBits = pEncoderCtx->bits_per_coded_sample;
+    VoIPStreamEncodedAudio::Frame frame;
+    while (encodeFrame(frame))
+        audio->frames.push_back(frame);
+    closeSoundFile();
+    audioCache->add(key.str(), audio);
+    encodedAudio = audio;
+    EV_INFO << "Encoded sound file '" << soundFile << "' into " << audio->frames.size() << " frames" << endl;
+}
+
 void VoIPStreamSender::openSoundFile(const char *name)
 {
     int ret;
@@ -300,17 +365,31 @@ void VoIPStreamSender::openSoundFile(const char *name)
 }
 
 VoIPStreamPacket* VoIPStreamSender::generatePacket()
+{
+    if (encodedAudio)
+    {
+        if (encodedFrameIndex >= encodedAudio->frames.size())
+            return NULL;
+        return createPacket(encodedAudio->frames[encodedFrameIndex++], encodedAudio->codec, encodedAudio->sampleBits);
+    }
+
+    VoIPStreamEncodedAudio::Frame frame;
+    if (!encodeFrame(frame))
+        return NULL;
+    return createPacket(frame, pEncoderCtx->codec_id, pEncoderCtx->bits_per_coded_sample);
+}
+
+bool VoIPStreamSender::encodeFrame(VoIPStreamEncodedAudio::Frame& encodedFrame)
 {
     readFrame();
 
     if (sampleBuffer.empty())
-        return NULL;
+        return false;
 
     short int bytesPerInSample = av_get_bytes_per_sample(pEncoderCtx->sample_fmt);
     int samples = std::min(sampleBuffer.length() / (bytesPerInSample), samplesPerPacket);
     int inBytes = samples * bytesPerInSample;
-    bool isSilent = checkSilence(pEncoderCtx->sample_fmt, sampleBuffer.readPtr(), samples);
-    VoIPStreamPacket *vp = new VoIPStreamPacket();
+    encodedFrame.isSilent = checkSilence(pEncoderCtx->sample_fmt, sampleBuffer.readPtr(), samples);
 
     AVPacket opacket;
     av_init_packet(&opacket);
@@ -340,9 +419,24 @@ VoIPStreamPacket* VoIPStreamSender::generatePacket()
         outFile.write(sampleBuffer.readPtr(), inBytes);
     sampleBuffer.notifyRead(inBytes);
 
-    vp->setDataFromBuffer(opacket.data, opacket.size);
+    encodedFrame.data.assign(opacket.data, opacket.data + opacket.size);
 
-    if (isSilent)
+    av_free_packet(&opacket);
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(54,28,0)
+    avcodec_free_frame(&frame);
+#else
+    av_freep(&frame);
+#endif
+    return true;
+}
+
+VoIPStreamPacket* VoIPStreamSender::createPacket(const VoIPStreamEncodedAudio::Frame& frame, int codecId, short sampleBits)
+{
+    VoIPStreamPacket *vp = new VoIPStreamPacket();
+    int size = frame.data.size();
+    vp->setDataFromBuffer(size ? &frame.data[0] : NULL, size);
+
+    if (frame.isSilent)
     {
         vp->setName("SILENCE");
         vp->setType(SILENCE);
@@ -352,25 +446,18 @@ VoIPStreamPacket* VoIPStreamSender::generatePacket()
     {
         vp->setName("VOICE");
         vp->setType(VOICE);
-        vp->setByteLength(voipHeaderSize + opacket.size);
+        vp->setByteLength(voipHeaderSize + size);
     }
 
     vp->setTimeStamp(pktID);
     vp->setSeqNo(pktID);
-    vp->setCodec(pEncoderCtx->codec_id);
+    vp->setCodec(codecId);
     vp->setSampleRate(sampleRate);
-    vp->setSampleBits(pEncoderCtx->bits_per_coded_sample);
+    vp->setSampleBits(sampleBits);
     vp->setSamplesPerPacket(samplesPerPacket);
     vp->setTransmitBitrate(compressedBitRate);
 
     pktID++;
-
-    av_free_packet(&opacket);
-#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(54,28,0)
-    avcodec_free_frame(&frame);
-#else
-    av_freep(&frame);
-#endif
     return vp;
 }
 
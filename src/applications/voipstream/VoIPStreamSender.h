@@ -47,6 +47,7 @@ extern "C" {
 #include "IPvXAddressResolver.h"
 #include "UDPSocket.h"
 #include "VoIPStreamPacket_m.h"
+#include "VoIPStreamEncodedAudioCache.h"
 #include "ILifecycle.h"
 #include "LifecycleOperation.h"
 
@@ -68,7 +69,12 @@ class INET_API VoIPStreamSender : public cSimpleModule, public ILifecycle
     virtual void finish();
 
     virtual void openSoundFile(const char *name);
+    virtual void closeSoundFile();
+    virtual void rewindSoundFile();
+    virtual void encodeSoundFile();
     virtual VoIPStreamPacket* generatePacket();
+    virtual bool encodeFrame(VoIPStreamEncodedAudio::Frame& frame);
+    virtual VoIPStreamPacket* createPacket(const VoIPStreamEncodedAudio::Frame& frame, int codecId, short sampleBits);
     virtual bool checkSilence(AVSampleFormat sampleFormat, void* _buf, int samples);
     virtual void readFrame();
 
@@ -111,6 +117,7 @@ class INET_API VoIPStreamSender : public cSimpleModule, public ILifecycle
     simtime_t packetTimeLength;
     const char *soundFile;          // input audio file name
     int repeatCount;
+    bool shareEncodedAudio;         // use the process-wide cache of encoded sound files
 
     const char *traceFileName;      // name of the output trace file, NULL or empty to turn off recording
     AudioOutFile outFile;
@@ -136,6 +143,9 @@ class INET_API VoIPStreamSender : public cSimpleModule, public ILifecycle
     int samplesPerPacket;
     AVPacket packet;
     Buffer sampleBuffer;
+    VoIPStreamEncodedAudioCache *audioCache;       // acquired in encodeSoundFile(), released in the destructor
+    const VoIPStreamEncodedAudio *encodedAudio;    // not NULL when the packets come from the cache
+    unsigned int encodedFrameIndex;
 
     cMessage *timer;
 
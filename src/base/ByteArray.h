@@ -75,6 +75,11 @@ class ByteArray : public ByteArray_Base
      */
     virtual unsigned int copyDataToBuffer(void *ptr, unsigned int length, unsigned int srcOffs = 0) const;
 
+    /**
+     * Returns the data content as one block of getDataArraySize() bytes (NULL if empty)
+     */
+    virtual const char *getDataPointer() const { return data_var; }
+
     /**
      * Set buffer pointer and buffer length
      * @param ptr: pointer to new buffer, must created by `buffer = new char[length1];` where length1>=length
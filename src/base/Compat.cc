@@ -15,13 +15,51 @@
 // along with this program; if not, see <http://www.gnu.org/licenses/>.
 //
 
-#include "Compat.h"
+#include "INETDefs.h"
 
 #ifdef EV_GLOBAL_STREAM
 // TODO: compiles but it doesn't do what it supposed to do
 cLogStream cLogStream::globalStream;
 #endif
 
+// Caches the record-eventlog setting of the current run. It is subscribed to
+// the system module of the network, and the cached value is dropped when that
+// module is deleted at the end of the run.
+class MethodCallRecordingCache : public cListener
+{
+  public:
+    int recordEventlog;  // -1: not known yet
+
+    MethodCallRecordingCache() : recordEventlog(-1) {}
+    virtual void unsubscribedFrom(cComponent *component, simsignal_t signalID)
+    {
+        cListener::unsubscribedFrom(component, signalID);
+        recordEventlog = -1;
+    }
+};
+
+static MethodCallRecordingCache methodCallRecordingCache;
+
+bool inetIsMethodCallRecorded()
+{
+    if (ev.isGUI())
+        return true;
+
+    // there is no public API to query event log recording, so look at the configuration once per run
+    if (methodCallRecordingCache.recordEventlog != -1)
+        return methodCallRecordingCache.recordEventlog;
+    const char *value = ev.getConfig()->getConfigValue("record-eventlog");
+    bool recordEventlog = cConfiguration::parseBool(value, "false");
+    cModule *systemModule = simulation.getSystemModule();
+    if (systemModule)
+    {
+        static simsignal_t cacheSignal = cComponent::registerSignal("inetMethodCallRecording");  // never emitted
+        systemModule->subscribe(cacheSignal, &methodCallRecordingCache);
+        methodCallRecordingCache.recordEventlog = recordEventlog ? 1 : 0;
+    }
+    return recordEventlog;
+}
+
 #ifdef _MSC_VER
 
 //
@@ -32,22 +32,43 @@
     typedef uint8_t  uint8;
 #endif  // OMNETPP_VERSION >= 0x500
 
+// Log levels, used for compile-time filtering of the EV_* macros below
+#define INET_LOGLEVEL_TRACE   0
+#define INET_LOGLEVEL_DEBUG   1
+#define INET_LOGLEVEL_DETAIL  2
+#define INET_LOGLEVEL_INFO    3
+#define INET_LOGLEVEL_WARN    4
+#define INET_LOGLEVEL_ERROR   5
+#define INET_LOGLEVEL_FATAL   6
+
+// Log statements below this level are compiled out together with the formatting
+// of their arguments, e.g. build with -DINET_MIN_LOGLEVEL=INET_LOGLEVEL_INFO.
+// A source file may redefine it after its #includes to get a different level.
+#ifndef INET_MIN_LOGLEVEL
+#  define INET_MIN_LOGLEVEL  INET_LOGLEVEL_TRACE
+#endif
+
 #if OMNETPP_VERSION < 0x500
-#  define EV_FATAL  EV << "FATAL: "
-#  define EV_ERROR  EV << "ERROR: "
-#  define EV_WARN   EV << "WARN: "
-#  define EV_INFO   EV
-#  define EV_DETAIL EV << "DETAIL: "
-#  define EV_DEBUG  EV << "DEBUG: "
-#  define EV_TRACE  EV << "TRACE: "
-
-#  define EV_FATAL_C(category)  EV << "[" << category << "] FATAL: "
-#  define EV_ERROR_C(category)  EV << "[" << category << "] ERROR: "
-#  define EV_WARN_C(category)   EV << "[" << category << "] WARN: "
-#  define EV_INFO_C(category)   EV << "[" << category << "] "
-#  define EV_DETAIL_C(category) EV << "[" << category << "] DETAIL: "
-#  define EV_DEBUG_C(category)  EV << "[" << category << "] DEBUG: "
-#  define EV_TRACE_C(category)  EV << "[" << category << "] TRACE: "
+// The for statement ensures that nothing after the macro is evaluated when the
+// statement is filtered out, and (unlike a bare if) it is safe inside if-else.
+#  define EV_LOG_IF(level, condition)  for (bool inet_log_enabled_ = (level) >= INET_MIN_LOGLEVEL && (condition) && !ev.isDisabled(); inet_log_enabled_; inet_log_enabled_ = false) EV
+#  define EV_LOG(level)  EV_LOG_IF(level, true)
+
+#  define EV_FATAL  EV_LOG(INET_LOGLEVEL_FATAL) << "FATAL: "
+#  define EV_ERROR  EV_LOG(INET_LOGLEVEL_ERROR) << "ERROR: "
+#  define EV_WARN   EV_LOG(INET_LOGLEVEL_WARN) << "WARN: "
+#  define EV_INFO   EV_LOG(INET_LOGLEVEL_INFO)
+#  define EV_DETAIL EV_LOG(INET_LOGLEVEL_DETAIL) << "DETAIL: "
+#  define EV_DEBUG  EV_LOG(INET_LOGLEVEL_DEBUG) << "DEBUG: "
+#  define EV_TRACE  EV_LOG(INET_LOGLEVEL_TRACE) << "TRACE: "
+
+#  define EV_FATAL_C(category)  EV_LOG(INET_LOGLEVEL_FATAL) << "[" << category << "] FATAL: "
+#  define EV_ERROR_C(category)  EV_LOG(INET_LOGLEVEL_ERROR) << "[" << category << "] ERROR: "
+#  define EV_WARN_C(category)   EV_LOG(INET_LOGLEVEL_WARN) << "[" << category << "] WARN: "
+#  define EV_INFO_C(category)   EV_LOG(INET_LOGLEVEL_INFO) << "[" << category << "] "
+#  define EV_DETAIL_C(category) EV_LOG(INET_LOGLEVEL_DETAIL) << "[" << category << "] DETAIL: "
+#  define EV_DEBUG_C(category)  EV_LOG(INET_LOGLEVEL_DEBUG) << "[" << category << "] DEBUG: "
+#  define EV_TRACE_C(category)  EV_LOG(INET_LOGLEVEL_TRACE) << "[" << category << "] TRACE: "
 
 #  define EV_STATICCONTEXT  /* Empty */
 
@@ -0,0 +1,66 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "FusedModuleBase.h"
+
+
+bool FusedModuleBase::isFused()
+{
+    if (fusedMode == FUSED_UNKNOWN)
+        fusedMode = (hasPar("fused") && par("fused").boolValue()) ? FUSED_ON : FUSED_OFF;
+    return fusedMode == FUSED_ON;
+}
+
+FusedModuleBase *FusedModuleBase::getFusedTarget(cGate *outGate)
+{
+    if (!isFused())
+        return NULL;
+
+    // packets may only bypass the event queue if no channel on the path
+    // could delay them or count them; the path is only a few gates long
+    // (through the enclosing compound module), so it is not worth caching
+    cGate *endGate = outGate->getPathEndGate();
+    if (endGate == outGate)
+        return NULL;  // not connected
+    for (cGate *g = outGate; g != endGate; g = g->getNextGate())
+    {
+        cChannel *channel = g->getChannel();
+        if (channel && !dynamic_cast<cIdealChannel *>(channel))
+            return NULL;
+    }
+
+    FusedModuleBase *target = dynamic_cast<FusedModuleBase *>(endGate->getOwnerModule());
+    return (target && target->isFused()) ? target : NULL;
+}
+
+void FusedModuleBase::sendFused(cMessage *msg, cGate *outGate)
+{
+    FusedModuleBase *target = getFusedTarget(outGate);
+    if (target)
+        target->receiveFused(msg, outGate->getPathEndGate());
+    else
+        send(msg, outGate);
+}
+
+void FusedModuleBase::receiveFused(cMessage *msg, cGate *inGate)
+{
+    Enter_Method_Silent();
+    take(msg);
+    msg->setArrival(this, inGate->getId(), simTime());
+    handleMessage(msg);
+}
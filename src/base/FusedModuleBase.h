@@ -0,0 +1,79 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __INET_FUSEDMODULEBASE_H
+#define __INET_FUSEDMODULEBASE_H
+
+#include "INETDefs.h"
+
+
+/**
+ * Base class for the simple modules that make up compound queue modules
+ * (e.g. ~DiffservQueue, ~AFxyQueue, ~EtherQoSQueue).
+ *
+ * Subclasses send packets to the next stage with sendFused(). If the
+ * "fused" parameter is true both in this module and in the module at the
+ * end of the gate's path, and the path consists of ideal connections only,
+ * the packet is handed over by a direct method call; otherwise it is sent
+ * as usual. The receiving module processes the packet in its
+ * handleMessage(), so signals and statistics are the same in both modes,
+ * but a packet passing through the whole queueing graph costs a single
+ * event. Modules without a "fused" parameter behave as if it was false.
+ */
+class INET_API FusedModuleBase : public cSimpleModule
+{
+  private:
+    enum { FUSED_UNKNOWN = -1, FUSED_OFF = 0, FUSED_ON = 1 };
+    int fusedMode;
+
+  protected:
+    /**
+     * Returns the module to which packets sent on the given gate can be
+     * handed over directly, or NULL if they have to be sent. The path is
+     * followed on every call, so gates connected or disconnected at
+     * runtime are taken into account.
+     */
+    virtual FusedModuleBase *getFusedTarget(cGate *outGate);
+
+    /**
+     * Passes the packet to the next stage by a direct call when possible,
+     * otherwise sends it on the gate.
+     */
+    virtual void sendFused(cMessage *msg, cGate *outGate);
+
+    /**
+     * Convenience variant of sendFused(); looks up the gate by name and index.
+     */
+    virtual void sendFused(cMessage *msg, const char *gateName, int gateIndex = -1) { sendFused(msg, gate(gateName, gateIndex)); }
+
+  public:
+    FusedModuleBase() : fusedMode(FUSED_UNKNOWN) {}
+
+    /**
+     * Returns the value of the "fused" parameter, or false if there is none.
+     */
+    bool isFused();
+
+    /**
+     * Processes the packet as if it had arrived on the given input gate,
+     * at the current simulation time.
+     */
+    virtual void receiveFused(cMessage *msg, cGate *inGate);
+};
+
+#endif
@@ -66,4 +66,16 @@ T *__checknull(T *p, const char *expr, const char *file, int line)
 
 #define PK(msg)  check_and_cast<cPacket *>(msg)    /*XXX temp def*/
 
+//
+// Like Enter_Method(), but the arguments are only evaluated and formatted when
+// the method call can be animated or recorded, i.e. under a GUI or when the
+// event log is recorded. Use it in frequently called methods whose arguments
+// are expensive to format (e.g. addresses).
+//
+#define Enter_Method_Lazy(...) \
+    cMethodCallContextSwitcher __ctx(this); \
+    if (!inetIsMethodCallRecorded()) __ctx.methodCallSilent(); else __ctx.methodCall(__VA_ARGS__)
+
+INET_API bool inetIsMethodCallRecorded();
+
 #endif  // __INET_INETDEFS_H
@@ -60,7 +60,7 @@ void NotificationBoard::handleMessage(cMessage *msg)
 
 void NotificationBoard::subscribe(INotifiable *client, int category)
 {
-    Enter_Method("subscribe(%s)", notificationCategoryName(category));
+    Enter_Method_Lazy("subscribe(%s)", notificationCategoryName(category));
 
     // find or create entry for this category
     NotifiableVector& clients = clientMap[category];
@@ -74,7 +74,7 @@ void NotificationBoard::subscribe(INotifiable *client, int category)
 
 void NotificationBoard::unsubscribe(INotifiable *client, int category)
 {
-    Enter_Method("unsubscribe(%s)", notificationCategoryName(category));
+    Enter_Method_Lazy("unsubscribe(%s)", notificationCategoryName(category));
 
     // find (or create) entry for this category
     NotifiableVector& clients = clientMap[category];
@@ -95,7 +95,7 @@ bool NotificationBoard::hasSubscribers(int category)
 
 void NotificationBoard::fireChangeNotification(int category, const cObject *details)
 {
-    Enter_Method("fireChangeNotification(%s, %s)", notificationCategoryName(category),
+    Enter_Method_Lazy("fireChangeNotification(%s, %s)", notificationCategoryName(category),
                  details?details->info().c_str() : "n/a");
 
     ClientMap::iterator it = clientMap.find(category);
@@ -0,0 +1,104 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "ObjectPool.h"
+
+
+static long defaultMaxPoolSize = 4096;
+
+std::vector<ObjectPool *>& ObjectPool::getPools()
+{
+    static std::vector<ObjectPool *> pools;
+    return pools;
+}
+
+ObjectPool::ObjectPool(const char *className, size_t blockSize, long maxPoolSize)
+{
+    if (blockSize < sizeof(FreeBlock))
+        throw cRuntimeError("ObjectPool: objects of class %s are too small to be pooled", className);
+    this->className = className;
+    this->blockSize = blockSize;
+    this->maxPoolSize = maxPoolSize;
+    freeList = NULL;
+    poolSize = peakPoolSize = 0;
+    numAllocations = numReused = 0;
+}
+
+ObjectPool *ObjectPool::create(const char *className, size_t blockSize)
+{
+    ObjectPool *pool = new ObjectPool(className, blockSize, defaultMaxPoolSize);
+    getPools().push_back(pool);
+    return pool;
+}
+
+void ObjectPool::trim()
+{
+    while (freeList != NULL)
+    {
+        FreeBlock *block = freeList;
+        freeList = block->next;
+        ::operator delete(block);
+    }
+    poolSize = 0;
+}
+
+void ObjectPool::setMaxPoolSize(long size)
+{
+    if (size < 0)
+        throw cRuntimeError("ObjectPool: invalid maximum pool size %ld", size);
+    defaultMaxPoolSize = size;
+    std::vector<ObjectPool *>& pools = getPools();
+    for (unsigned int i = 0; i < pools.size(); i++)
+    {
+        pools[i]->maxPoolSize = size;
+        if (pools[i]->poolSize > size)
+            pools[i]->trim();
+    }
+}
+
+void ObjectPool::trimAll()
+{
+    std::vector<ObjectPool *>& pools = getPools();
+    for (unsigned int i = 0; i < pools.size(); i++)
+        pools[i]->trim();
+}
+
+void ObjectPool::printStatistics(std::ostream& os)
+{
+    std::vector<ObjectPool *>& pools = getPools();
+    for (unsigned int i = 0; i < pools.size(); i++)
+    {
+        const ObjectPool *pool = pools[i];
+        os << pool->className << ": " << pool->numAllocations << " allocations, "
+           << pool->numReused << " served from pool, peak pool size " << pool->peakPoolSize
+           << " (" << pool->blockSize << " bytes each)\n";
+    }
+}
+
+void ObjectPool::recordStatistics(cComponent *component)
+{
+    std::vector<ObjectPool *>& pools = getPools();
+    for (unsigned int i = 0; i < pools.size(); i++)
+    {
+        const ObjectPool *pool = pools[i];
+        std::string name = pool->className;
+        component->recordScalar((name + " allocations").c_str(), pool->numAllocations);
+        component->recordScalar((name + " allocations avoided").c_str(), pool->numReused);
+        component->recordScalar((name + " peak pool size").c_str(), pool->peakPoolSize);
+    }
+}
+
@@ -0,0 +1,166 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __INET_OBJECTPOOL_H
+#define __INET_OBJECTPOOL_H
+
+#include <vector>
+#include "INETDefs.h"
+
+
+/**
+ * Storage class specifier for the per-class pool pointers. Empty for the
+ * sequential simulation kernel; define it as __thread (or thread_local)
+ * to get a separate set of pools per thread.
+ */
+#ifndef INET_POOL_THREAD_LOCAL
+#define INET_POOL_THREAD_LOCAL
+#endif
+
+/**
+ * Free list of fixed-size memory blocks for the instances of one class.
+ * Blocks of deleted objects are kept (up to a limit) and handed out again
+ * by the next allocation, so that the per-packet new/delete of frequently
+ * used message classes does not go to malloc/free.
+ *
+ * A class opts in with the INET_POOLED_ALLOCATION() macro, which defines
+ * class-specific operator new and delete. Subclasses that do not use the
+ * macro themselves inherit these operators; as their objects are larger,
+ * they are simply passed to the global operator new/delete.
+ *
+ * Pools are created on first use and never destroyed (objects may well be
+ * deleted during static deinitialization). Compile with
+ * -DWITHOUT_OBJECT_POOLS to turn pooling off, e.g. for memory debugging.
+ */
+class INET_API ObjectPool
+{
+  protected:
+    struct FreeBlock { FreeBlock *next; };
+
+    const char *className;
+    size_t blockSize;
+    FreeBlock *freeList;
+    long maxPoolSize;
+
+    // statistics
+    long poolSize;
+    long peakPoolSize;
+    long numAllocations;
+    long numReused;
+
+    static std::vector<ObjectPool *>& getPools();
+
+  protected:
+    ObjectPool(const char *className, size_t blockSize, long maxPoolSize);
+
+  public:
+    /**
+     * Creates and registers a pool for objects of the given size.
+     */
+    static ObjectPool *create(const char *className, size_t blockSize);
+
+    /**
+     * Returns a block of the given size, from the pool if possible.
+     */
+    void *allocate(size_t size)
+    {
+        numAllocations++;
+        if (size != blockSize || freeList == NULL)
+            return ::operator new(size);
+        FreeBlock *block = freeList;
+        freeList = block->next;
+        poolSize--;
+        numReused++;
+        return block;
+    }
+
+    /**
+     * Returns the block to the pool, or frees it if the pool is full.
+     */
+    void release(void *p, size_t size)
+    {
+        if (p == NULL)
+            return;
+        if (size != blockSize || poolSize >= maxPoolSize) {
+            ::operator delete(p);
+            return;
+        }
+        FreeBlock *block = static_cast<FreeBlock *>(p);
+        block->next = freeList;
+        freeList = block;
+        if (++poolSize > peakPoolSize)
+            peakPoolSize = poolSize;
+    }
+
+    /**
+     * Frees all blocks kept in the pool.
+     */
+    void trim();
+
+    /** @name Statistics */
+    //@{
+    const char *getClassName() const { return className; }
+    long getPoolSize() const { return poolSize; }
+    long getPeakPoolSize() const { return peakPoolSize; }
+    long getNumAllocations() const { return numAllocations; }
+    long getNumAllocationsAvoided() const { return numReused; }
+    //@}
+
+    /**
+     * Sets the maximum number of blocks kept by each pool (default: 4096).
+     */
+    static void setMaxPoolSize(long size);
+
+    /**
+     * Frees the blocks kept in all pools.
+     */
+    static void trimAll();
+
+    /**
+     * Prints the statistics of all pools, one line per pooled class.
+     */
+    static void printStatistics(std::ostream& os);
+
+    /**
+     * Records the statistics of all pools as scalars of the given module:
+     * "<class> allocations", "<class> allocations avoided" and
+     * "<class> peak pool size".
+     */
+    static void recordStatistics(cComponent *component);
+};
+
+#ifndef WITHOUT_OBJECT_POOLS
+/**
+ * Put this macro into the body of a class to allocate its instances from
+ * an ObjectPool.
+ */
+#define INET_POOLED_ALLOCATION(CLASSNAME) \
+  public: \
+    static ObjectPool& getObjectPool() { \
+        static INET_POOL_THREAD_LOCAL ObjectPool *pool = NULL; \
+        if (pool == NULL) \
+            pool = ObjectPool::create(#CLASSNAME, sizeof(CLASSNAME)); \
+        return *pool; \
+    } \
+    static void *operator new(size_t size) { return getObjectPool().allocate(size); } \
+    static void operator delete(void *p, size_t size) { getObjectPool().release(p, size); }
+#else
+#define INET_POOLED_ALLOCATION(CLASSNAME)
+#endif
+
+#endif
+
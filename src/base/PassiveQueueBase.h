@@ -23,6 +23,8 @@
 
 #include "INETDefs.h"
 
+#include "FusedModuleBase.h"
+
 #include "IPassiveQueue.h"
 
 
@@ -32,7 +34,7 @@
  * subclasses; the actual queue or piority queue data structure
  * also goes into subclasses.
  */
-class INET_API PassiveQueueBase : public cSimpleModule, public IPassiveQueue
+class INET_API PassiveQueueBase : public FusedModuleBase, public IPassiveQueue
 {
   protected:
     std::list<IPassiveQueueListener*> listeners;
@@ -26,104 +26,104 @@
 
 ReassemblyBuffer::ReassemblyBuffer()
 {
-    main.beg = main.end = 0;
-    main.islast = false;
-    fragments = NULL;
+    regions = inlineRegions;
+    numRegions = 0;
+    capacity = INLINE_REGIONS;
+    haveLast = false;
+    totalLength = 0;
 }
 
-ReassemblyBuffer::~ReassemblyBuffer()
+ReassemblyBuffer::ReassemblyBuffer(const ReassemblyBuffer& other)
 {
-    delete fragments;
+    regions = inlineRegions;
+    capacity = INLINE_REGIONS;
+    copy(other);
 }
 
-bool ReassemblyBuffer::addFragment(ushort beg, ushort end, bool islast)
+ReassemblyBuffer::~ReassemblyBuffer()
 {
-    merge(beg, end, islast);
+    if (regions != inlineRegions)
+        delete [] regions;
+}
 
-    // do we have the complete datagram?
-    return main.beg==0 && main.islast;
+ReassemblyBuffer& ReassemblyBuffer::operator=(const ReassemblyBuffer& other)
+{
+    if (this != &other)
+        copy(other);
+    return *this;
 }
 
-void ReassemblyBuffer::merge(ushort beg, ushort end, bool islast)
+void ReassemblyBuffer::copy(const ReassemblyBuffer& other)
 {
-    if (main.end==beg)
+    if (other.numRegions > capacity)
     {
-        // most typical case (<95%): new fragment follows last one
-        main.end = end;
-        if (islast)
-            main.islast = true;
-        if (fragments)
-            mergeFragments();
+        if (regions != inlineRegions)
+            delete [] regions;
+        regions = new Region[other.capacity];
+        capacity = other.capacity;
     }
-    else if (main.beg==end)
-    {
-        // new fragment precedes what we already have
-        main.beg = beg;
-        if (fragments)
-            mergeFragments();
-    }
-    else if (main.end<beg || main.beg>end)
+    memcpy(regions, other.regions, other.numRegions * sizeof(Region));
+    numRegions = other.numRegions;
+    haveLast = other.haveLast;
+    totalLength = other.totalLength;
+}
+
+bool ReassemblyBuffer::addFragment(ushort beg, ushort end, bool islast)
+{
+    if (islast)
     {
-        // disjoint fragment, store it until another fragment fills in the gap
-        if (!fragments)
-            fragments = new RegionVector();
-        Region r;
-        r.beg = beg;
-        r.end = end;
-        r.islast = islast;
-        fragments->push_back(r);
+        haveLast = true;
+        totalLength = end;
     }
-    else
+
+    if (beg < end)
     {
-        // overlapping is not possible;
-        // fragment's range already contained in buffer (probably duplicate fragment)
+        // regions [i,j) overlap or touch the new fragment; when fragments
+        // arrive in order, i is the last region and j==numRegions
+        int i = numRegions;
+        while (i > 0 && regions[i-1].end >= beg)
+            i--;
+        int j = i;
+        while (j < numRegions && regions[j].beg <= end)
+            j++;
+
+        if (i == j)
+            insertRegion(i, beg, end);  // disjoint fragment, store it until another fragment fills in the gap
+        else
+        {
+            if (beg < regions[i].beg)
+                regions[i].beg = beg;
+            regions[i].end = end > regions[j-1].end ? end : regions[j-1].end;
+            eraseRegions(i+1, j-i-1);
+        }
     }
+
+    // do we have the complete datagram?
+    return isComplete();
 }
 
-void ReassemblyBuffer::mergeFragments()
+void ReassemblyBuffer::insertRegion(int pos, ushort beg, ushort end)
 {
-    RegionVector& frags = *fragments;
-
-    bool oncemore;
-    do
+    if (numRegions == capacity)
     {
-        oncemore = false;
-        for (RegionVector::iterator i=frags.begin(); i!=frags.end(); )
-        {
-            bool deleteit = false;
-            Region& frag = *i;
-            if (main.end==frag.beg)
-            {
-                main.end = frag.end;
-                if (frag.islast)
-                    main.islast = true;
-                deleteit = true;
-            }
-            else if (main.beg==frag.end)
-            {
-                main.beg = frag.beg;
-                deleteit = true;
-            }
-            else if (main.beg<=frag.beg && main.end>=frag.end)
-            {
-                // we already have this region (duplicate fragment), delete it
-                deleteit = true;
-            }
-
-            if (deleteit)
-            {
-                // deletion is tricky because erase() invalidates iterator
-                int pos = i - frags.begin();
-                frags.erase(i);
-                i = frags.begin() + pos;
-                oncemore = true;
-            }
-            else
-            {
-                ++i;
-            }
-        }
+        Region *newRegions = new Region[2 * capacity];
+        memcpy(newRegions, regions, numRegions * sizeof(Region));
+        if (regions != inlineRegions)
+            delete [] regions;
+        regions = newRegions;
+        capacity *= 2;
     }
-    while (oncemore);
+    memmove(regions + pos + 1, regions + pos, (numRegions - pos) * sizeof(Region));
+    regions[pos].beg = beg;
+    regions[pos].end = end;
+    numRegions++;
+}
+
+void ReassemblyBuffer::eraseRegions(int pos, int count)
+{
+    if (count == 0)
+        return;
+    memmove(regions + pos, regions + pos + count, (numRegions - pos - count) * sizeof(Region));
+    numRegions -= count;
 }
 
@@ -18,8 +18,6 @@
 #ifndef __INET_REASSEMBLYBUFFER_H
 #define __INET_REASSEMBLYBUFFER_H
 
-#include <map>
-#include <vector>
 #include "INETDefs.h"
 
 
@@ -36,26 +34,28 @@ class INET_API ReassemblyBuffer
     {
         ushort beg;   // first offset stored
         ushort end;   // last+1 offset stored
-        bool islast;  // if this region represents the last bytes of the datagram
     };
 
-    typedef std::vector<Region> RegionVector;
-
     //
-    // Thinking of IPv4/IPv6 fragmentation, 99% of the time fragments
-    // will arrive in order and none gets lost, so we have to
-    // handle this case very efficiently. For this purpose
-    // we'll store the offset of the first and last+1 byte we have
-    // (main.beg, main.end variables), and keep extending this range
-    // as new fragments arrive. If we receive non-connecting fragments,
-    // put them aside into buf until new fragments come and fill the gap.
+    // The offset ranges received so far, as a sorted set of disjoint,
+    // non-adjacent regions. Thinking of IPv4/IPv6 fragmentation, 99% of
+    // the time fragments will arrive in order and none gets lost, so there
+    // is a single region that keeps being extended. Reordered or lost
+    // fragments open a few more regions; these fit into the inline slots,
+    // so a heap array is only allocated for badly fragmented datagrams.
     //
-    Region main;   // offset range we already have
-    RegionVector *fragments;  // only used if we receive disjoint fragments
+    enum { INLINE_REGIONS = 4 };
+    Region inlineRegions[INLINE_REGIONS];
+    Region *regions;      // inlineRegions, or a heap array of 'capacity' regions
+    ushort numRegions;
+    ushort capacity;
+    bool haveLast;        // the fragment with the end of the datagram has arrived
+    ushort totalLength;   // end offset of the last fragment, if haveLast
 
   protected:
-    void merge(ushort beg, ushort end, bool islast);
-    void mergeFragments();
+    void insertRegion(int pos, ushort beg, ushort end);
+    void eraseRegions(int pos, int count);
+    void copy(const ReassemblyBuffer& other);
 
   public:
     /**
@@ -63,23 +63,40 @@ class INET_API ReassemblyBuffer
      */
     ReassemblyBuffer();
 
+    /**
+     * Copy ctor.
+     */
+    ReassemblyBuffer(const ReassemblyBuffer& other);
+
     /**
      * Dtor.
      */
     ~ReassemblyBuffer();
 
+    /**
+     * Assignment.
+     */
+    ReassemblyBuffer& operator=(const ReassemblyBuffer& other);
+
     /**
      * Add a fragment, and returns true if reassembly has completed
      * (i.e. we have everything from offset 0 to the last fragment).
+     * Duplicate and overlapping fragments are merged.
      */
     bool addFragment(ushort beg, ushort end, bool islast);
 
+    /**
+     * Returns true if we have everything from offset 0 to the last fragment.
+     */
+    bool isComplete() const {
+        return haveLast && (totalLength == 0 || (numRegions == 1 && regions[0].beg == 0 && regions[0].end >= totalLength));
+    }
+
     /**
      * Returns the total (assembled) length of the datagram.
      * Can only be called after addFragment() returned true.
      */
-    ushort getTotalLength() const {return main.end;}
+    ushort getTotalLength() const {return totalLength;}
 };
 
 #endif
-
@@ -0,0 +1,175 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __INET_REASSEMBLYBUFFERTABLE_H
+#define __INET_REASSEMBLYBUFFERTABLE_H
+
+#include <map>
+#include "INETDefs.h"
+#include "ReassemblyBuffer.h"
+
+
+/**
+ * The reassembly buffers of the datagrams being reassembled by a network
+ * layer, looked up by a protocol-specific key (identification, source and
+ * destination address). Besides the lookup map, the buffers are threaded
+ * on an intrusive list in the order of their timestamps (creation or last
+ * update time, whichever the protocol uses for timeouts), so timed out
+ * buffers are found at the head of the list without scanning the map.
+ *
+ * The table owns the datagrams stored in the buffers: remove() hands the
+ * datagram over to the caller, while clear() and the destructor delete it.
+ *
+ * Used by IPv4FragBuf and IPv6FragBuf.
+ */
+template <class Key, class Datagram>
+class ReassemblyBufferTable
+{
+  public:
+    struct Buffer
+    {
+        Key key;
+        ReassemblyBuffer buf;   // offset ranges received
+        Datagram *datagram;     // the fragment kept for the reassembled datagram
+        simtime_t timestamp;    // ordering key of the expiry list
+        long bytes;             // fragment bytes received into this buffer
+        Buffer *prev;           // expiry list
+        Buffer *next;
+    };
+
+  protected:
+    typedef std::map<Key, Buffer> BufferMap;
+
+    BufferMap buffers;
+    Buffer *head;   // oldest timestamp
+    Buffer *tail;   // newest timestamp
+
+    // statistics
+    long bytesHeld;
+    long maxBytesHeld;
+    long numReassembled;
+    long numTimedOut;
+
+  protected:
+    void unlink(Buffer *buffer) {
+        (buffer->prev ? buffer->prev->next : head) = buffer->next;
+        (buffer->next ? buffer->next->prev : tail) = buffer->prev;
+        buffer->prev = buffer->next = NULL;
+    }
+
+    void append(Buffer *buffer) {
+        buffer->prev = tail;
+        buffer->next = NULL;
+        (tail ? tail->next : head) = buffer;
+        tail = buffer;
+    }
+
+  public:
+    ReassemblyBufferTable() : head(NULL), tail(NULL), bytesHeld(0), maxBytesHeld(0), numReassembled(0), numTimedOut(0) {}
+
+    ~ReassemblyBufferTable() {clear();}
+
+    /**
+     * Returns the buffer for the given key, or NULL if there is none.
+     */
+    Buffer *find(const Key& key) {
+        typename BufferMap::iterator it = buffers.find(key);
+        return it == buffers.end() ? NULL : &it->second;
+    }
+
+    /**
+     * Creates an empty buffer for the given key, and puts it at the tail of
+     * the expiry list. Timestamps must not decrease from call to call.
+     */
+    Buffer *create(const Key& key, simtime_t now) {
+        Buffer& buffer = buffers[key];
+        buffer.key = key;
+        buffer.datagram = NULL;
+        buffer.timestamp = now;
+        buffer.bytes = 0;
+        append(&buffer);
+        return &buffer;
+    }
+
+    /**
+     * Updates the timestamp of the buffer, moving it to the tail of the
+     * expiry list.
+     */
+    void touch(Buffer *buffer, simtime_t now) {
+        buffer->timestamp = now;
+        if (buffer != tail) {
+            unlink(buffer);
+            append(buffer);
+        }
+    }
+
+    /**
+     * Accounts for fragment bytes received into the buffer.
+     */
+    void addBytes(Buffer *buffer, long bytes) {
+        buffer->bytes += bytes;
+        bytesHeld += bytes;
+        if (bytesHeld > maxBytesHeld)
+            maxBytesHeld = bytesHeld;
+    }
+
+    /**
+     * Returns the buffer with the oldest timestamp, or NULL if the table is empty.
+     */
+    Buffer *getOldest() const {return head;}
+
+    /**
+     * Removes the buffer and returns its datagram, which is then owned by
+     * the caller. Set timedOut to count the removal as a reassembly timeout,
+     * otherwise it counts as a reassembled datagram.
+     */
+    Datagram *remove(Buffer *buffer, bool timedOut) {
+        Datagram *datagram = buffer->datagram;
+        bytesHeld -= buffer->bytes;
+        if (timedOut)
+            numTimedOut++;
+        else
+            numReassembled++;
+        unlink(buffer);
+        buffers.erase(buffer->key);
+        return datagram;
+    }
+
+    /**
+     * Deletes all buffers along with their datagrams.
+     */
+    void clear() {
+        for (typename BufferMap::iterator it = buffers.begin(); it != buffers.end(); ++it)
+            delete it->second.datagram;
+        buffers.clear();
+        head = tail = NULL;
+        bytesHeld = 0;
+    }
+
+    /** @name Statistics */
+    //@{
+    int getNumBuffers() const {return buffers.size();}
+    long getBytesHeld() const {return bytesHeld;}
+    long getMaxBytesHeld() const {return maxBytesHeld;}
+    long getNumReassembled() const {return numReassembled;}
+    long getNumTimedOut() const {return numTimedOut;}
+    //@}
+};
+
+#endif
+
@@ -20,11 +20,13 @@
 
 #include "INETDefs.h"
 
+#include "FusedModuleBase.h"
+
 /**
  * A module that just deletes every packet it receives, and collects
  * basic statistics (packet count, bit count, packet rate, bit rate).
  */
-class INET_API Sink : public cSimpleModule
+class INET_API Sink : public FusedModuleBase
 {
   protected:
     int numPackets;
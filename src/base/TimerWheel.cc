@@ -0,0 +1,174 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "TimerWheel.h"
+
+
+TimerWheel::TimerWheel(cSimpleModule *owner, simtime_t granularity, const char *tickName)
+{
+    if (granularity < SIMTIME_ZERO)
+        throw cRuntimeError("TimerWheel: granularity must not be negative");
+    this->owner = owner;
+    this->granularity = granularity.raw();
+    tickMsg = new cMessage(tickName);
+    lastGeneration = 0;
+    numScheduled = numLazyReschedules = numTicks = 0;
+}
+
+TimerWheel::~TimerWheel()
+{
+    owner->cancelAndDelete(tickMsg);
+}
+
+int64 TimerWheel::getTick(simtime_t t) const
+{
+    if (granularity == 0)
+        return t.raw();
+    return (t.raw() + granularity - 1) / granularity;
+}
+
+simtime_t TimerWheel::getTickTime(int64 tick) const
+{
+    simtime_t t;
+    t.setRaw(granularity == 0 ? tick : tick * granularity);
+    return t;
+}
+
+void TimerWheel::fileTimer(cMessage *timer, TimerState& state, int64 tick)
+{
+    state.generation = ++lastGeneration;
+    state.filedTick = tick;
+    buckets[tick].push_back(Slot(timer, state.generation));
+}
+
+void TimerWheel::scheduleTick()
+{
+    if (buckets.empty())
+    {
+        if (tickMsg->isScheduled())
+            owner->cancelEvent(tickMsg);
+        return;
+    }
+    simtime_t tickTime = getTickTime(buckets.begin()->first);
+    if (tickMsg->isScheduled())
+    {
+        if (tickMsg->getArrivalTime() == tickTime)
+            return;
+        owner->cancelEvent(tickMsg);
+    }
+    owner->scheduleAt(tickTime, tickMsg);
+}
+
+void TimerWheel::scheduleAt(simtime_t t, cMessage *timer)
+{
+    if (t < simTime())
+        throw cRuntimeError("TimerWheel: cannot schedule timer (%s)%s into the past", timer->getClassName(), timer->getName());
+
+    TimerStateMap::iterator it = timers.find(timer);
+    if (it == timers.end())
+    {
+        TimerState state;
+        state.scheduled = false;
+        state.tick = state.filedTick = -1;
+        state.generation = 0;
+        it = timers.insert(std::make_pair(timer, state)).first;
+    }
+    TimerState& state = it->second;
+    if (state.scheduled)
+        throw cRuntimeError("TimerWheel: timer (%s)%s is already scheduled", timer->getClassName(), timer->getName());
+
+    numScheduled++;
+    state.scheduled = true;
+    state.arrivalTime = t;
+    state.tick = getTick(t);
+    if (state.filedTick >= 0 && state.filedTick <= state.tick)
+    {
+        // the existing wakeup entry will move the timer forward when it comes due
+        numLazyReschedules++;
+        return;
+    }
+    fileTimer(timer, state, state.tick);
+    if (!tickMsg->isScheduled() || getTickTime(state.tick) < tickMsg->getArrivalTime())
+        scheduleTick();
+}
+
+cMessage *TimerWheel::cancel(cMessage *timer)
+{
+    TimerStateMap::iterator it = timers.find(timer);
+    if (it != timers.end())
+        it->second.scheduled = false;
+    return timer;
+}
+
+bool TimerWheel::isScheduled(cMessage *timer) const
+{
+    TimerStateMap::const_iterator it = timers.find(timer);
+    return it != timers.end() && it->second.scheduled;
+}
+
+simtime_t TimerWheel::getArrivalTime(cMessage *timer) const
+{
+    TimerStateMap::const_iterator it = timers.find(timer);
+    return it != timers.end() && it->second.scheduled ? it->second.arrivalTime : SIMTIME_ZERO;
+}
+
+cMessage *TimerWheel::popExpiredTimer()
+{
+    int64 now = getTick(simTime());
+    while (!buckets.empty() && buckets.begin()->first <= now)
+    {
+        BucketMap::iterator bucket = buckets.begin();
+        if (bucket->second.empty())
+        {
+            buckets.erase(bucket);
+            numTicks++;
+            continue;
+        }
+        Slot slot = bucket->second.front();
+        bucket->second.pop_front();
+
+        // stale entry: timer was deleted, or refiled to an earlier tick
+        TimerStateMap::iterator it = timers.find(slot.timer);
+        if (it == timers.end() || it->second.generation != slot.generation)
+            continue;
+        TimerState& state = it->second;
+        if (!state.scheduled)
+        {
+            // cancelled, and not rescheduled since: the timer may well be deleted by now
+            timers.erase(it);
+            continue;
+        }
+        if (state.tick > bucket->first)
+        {
+            // rescheduled for later while it was waiting in this bucket
+            fileTimer(slot.timer, state, state.tick);
+            continue;
+        }
+        // expired: the timer has no wakeup entry left, so forget it
+        timers.erase(it);
+        return slot.timer;
+    }
+    scheduleTick();
+    return NULL;
+}
+
+void TimerWheel::clear()
+{
+    timers.clear();
+    buckets.clear();
+    owner->cancelEvent(tickMsg);
+}
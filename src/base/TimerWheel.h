@@ -0,0 +1,157 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __INET_TIMERWHEEL_H
+#define __INET_TIMERWHEEL_H
+
+#include <deque>
+#include <map>
+#include "INETDefs.h"
+
+
+/**
+ * Keeps the timers (self-messages) of a protocol module out of the future
+ * event set. Timers are filed into buckets of a calendar, indexed by their
+ * expiry tick; only a single "tick" self-message, scheduled for the earliest
+ * non-empty bucket, is in the FES.
+ *
+ * Cancellation is lazy: cancel() only marks the timer, and a timer that is
+ * rescheduled for a later time stays in its bucket and is moved forward when
+ * that bucket comes due. This makes the typical "restart the retransmission
+ * timer on every ACK" pattern free of any FES operation.
+ *
+ * With zero granularity (the default) timers expire at their exact
+ * scheduled time. With a positive granularity, expiry times are rounded
+ * up to a multiple of the granularity, so timers are never early but may
+ * be late by less than one granularity.
+ *
+ * The owner module must recognize the tick message with isTick(), and
+ * then process the expired timers one by one with popExpiredTimer():
+ *
+ * <pre>
+ * if (timerWheel->isTick(msg)) {
+ *     while (cMessage *timer = timerWheel->popExpiredTimer())
+ *         processTimer(timer);
+ * }
+ * </pre>
+ *
+ * Timers may be cancelled, rescheduled or deleted while expired timers
+ * are being processed. Deleting a timer requires no special care beyond
+ * cancelling it first, just like with cancelEvent().
+ *
+ * Used by TCP, SCTP and ARP.
+ */
+class INET_API TimerWheel
+{
+  protected:
+    struct TimerState
+    {
+        bool scheduled;
+        simtime_t arrivalTime;
+        int64 tick;             // tick of arrivalTime
+        int64 filedTick;        // bucket that has a wakeup entry for this timer, or -1
+        unsigned long generation;
+    };
+
+    struct Slot
+    {
+        cMessage *timer;
+        unsigned long generation;
+        Slot(cMessage *timer, unsigned long generation) : timer(timer), generation(generation) {}
+    };
+
+    typedef std::map<cMessage *, TimerState> TimerStateMap;
+    typedef std::map<int64, std::deque<Slot> > BucketMap;
+
+    cSimpleModule *owner;
+    int64 granularity;          // in raw simtime units; 0 means exact expiry times
+    cMessage *tickMsg;
+    TimerStateMap timers;
+    BucketMap buckets;
+    unsigned long lastGeneration;
+
+    // statistics
+    long numScheduled;
+    long numLazyReschedules;
+    long numTicks;
+
+  protected:
+    int64 getTick(simtime_t t) const;
+    simtime_t getTickTime(int64 tick) const;
+    void fileTimer(cMessage *timer, TimerState& state, int64 tick);
+    void scheduleTick();
+
+  public:
+    /**
+     * Creates a timer wheel whose tick message is scheduled in the owner module.
+     */
+    TimerWheel(cSimpleModule *owner, simtime_t granularity = SIMTIME_ZERO, const char *tickName = "timerWheelTick");
+
+    /**
+     * Cancels and deletes the tick message. Timers are not deleted.
+     */
+    virtual ~TimerWheel();
+
+    /**
+     * Schedules the timer to expire at the given time. It is an error to
+     * schedule a timer that is already scheduled.
+     */
+    virtual void scheduleAt(simtime_t t, cMessage *timer);
+
+    /**
+     * Cancels the timer if it is scheduled, and returns it.
+     */
+    virtual cMessage *cancel(cMessage *timer);
+
+    /**
+     * Returns true if the timer is scheduled in this timer wheel.
+     */
+    virtual bool isScheduled(cMessage *timer) const;
+
+    /**
+     * Returns the time the timer was scheduled for (even if it will only be
+     * delivered at the next granularity boundary).
+     */
+    virtual simtime_t getArrivalTime(cMessage *timer) const;
+
+    /**
+     * Returns true if msg is the tick message of this timer wheel.
+     */
+    bool isTick(cMessage *msg) const { return msg == tickMsg; }
+
+    /**
+     * Returns the next timer that has expired by now, or NULL if there are
+     * no more. To be called after the tick message has arrived; the tick is
+     * rescheduled when NULL is returned.
+     */
+    virtual cMessage *popExpiredTimer();
+
+    /**
+     * Forgets all timers and cancels the tick message. Timers are not deleted.
+     */
+    virtual void clear();
+
+    /** @name Statistics */
+    //@{
+    int getNumTimers() const { return timers.size(); }
+    long getNumScheduled() const { return numScheduled; }
+    long getNumLazyReschedules() const { return numLazyReschedules; }
+    long getNumTicks() const { return numTicks; }
+    //@}
+};
+
+#endif
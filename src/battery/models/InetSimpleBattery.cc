@@ -67,7 +67,10 @@ void InetSimpleBattery::initialize(int stage)
         lifetime = -1; // -1 means not dead
 
         publishTime = par("publishTime");
-        if (publishTime > 0)
+        publishStartTime = simTime();
+        // with resolution == 0, the effect of the publish timer is computed
+        // lazily in deductAndCheck()
+        if (publishTime > 0 && resolution > 0)
         {
             lastUpdateTime = simTime();
             publish = new cMessage("publish", PUBLISH);
@@ -86,7 +89,8 @@ void InetSimpleBattery::initialize(int stage)
 
         timeout = new cMessage("auto-update", AUTO_UPDATE);
         timeout->setSchedulingPriority(500);
-        scheduleAt(simTime() + resolution, timeout);
+        if (resolution > 0)
+            scheduleAt(simTime() + resolution, timeout);
         lastUpdateTime = simTime();
         WATCH(lastPublishCapacity);
     }
@@ -166,8 +170,11 @@ void InetSimpleBattery::handleMessage(cMessage *msg)
         {
         case AUTO_UPDATE:
             // update the residual capacity (ongoing current draw)
-            scheduleAt(simTime() + resolution, timeout);
+            if (resolution > 0)
+                scheduleAt(simTime() + resolution, timeout);
             deductAndCheck();
+            if (resolution == 0)
+                scheduleNextUpdate();
             break;
 
         case PUBLISH:
@@ -222,6 +229,8 @@ void InetSimpleBattery::receiveChangeNotification(int aCategory, const cObject*
         // set the new current draw in the device vector
         it->second->draw = current;
         it->second->currentActivity = rs->getState();
+        if (resolution == 0)
+            scheduleNextUpdate();
     }
 }
 
@@ -244,6 +253,8 @@ void InetSimpleBattery::draw(int deviceID, DrawAmount& amount, int activity)
         // set the new current draw in the device vector
         deviceEntryVector[deviceID]->draw = current;
         deviceEntryVector[deviceID]->currentActivity = activity;
+        if (resolution == 0)
+            scheduleNextUpdate();
     }
     else if (amount.getType() == DrawAmount::ENERGY)
     {
@@ -256,13 +267,17 @@ void InetSimpleBattery::draw(int deviceID, DrawAmount& amount, int activity)
         EV << simTime() << " device " << deviceID <<  " deduct " << energy <<
         " mW-s, activity = " << activity << endl;
 
-        // deduct a fixed energy cost
+        // update the residual capacity (ongoing current draw) first; with
+        // resolution == 0 this also applies the publish timers that fired
+        // since the last update, which must not see this deduction yet
+        deductAndCheck();
+
+        // deduct a fixed energy cost, and check whether to publish (or perish)
         deviceEntryVector[deviceID]->accts[activity] += energy;
         residualCapacity -= energy;
-
-        // update the residual capacity (ongoing current draw), mostly
-        // to check whether to publish (or perish)
-        deductAndCheck();
+        checkCapacity();
+        if (resolution == 0)
+            scheduleNextUpdate();
     }
     else
     {
@@ -304,6 +319,15 @@ void InetSimpleBattery::deductAndCheck()
 
     simtime_t now = simTime();
 
+    // apply the publish timer that would have fired since the last update:
+    // it sets lastPublishCapacity to the residual capacity of that moment
+    if (resolution == 0 && publishTime > 0)
+    {
+        simtime_t publishAt = getLastPublishTime(now);
+        if (publishAt >= lastUpdateTime)
+            lastPublishCapacity = residualCapacity - getCurrentPower() * (publishAt - lastUpdateTime).dbl();
+    }
+
     // If device[i] has never drawn current (e.g. because the device
     // hasn't been used yet or only uses ENERGY) the currentActivity is
     // still -1.  If the device is not drawing current at the moment,
@@ -345,6 +369,11 @@ void InetSimpleBattery::deductAndCheck()
 
     EV << "residual capacity = " << residualCapacity << "\n";
 
+    checkCapacity();
+}
+
+void InetSimpleBattery::checkCapacity()
+{
     cDisplayString* display_string = &getParentModule()->getDisplayString();
 
     // battery is depleted
@@ -376,3 +405,94 @@ void InetSimpleBattery::deductAndCheck()
     if (mCurrEnergy)
         mCurrEnergy->record(capacity-residualCapacity);
 }
+
+double InetSimpleBattery::getCurrentPower()
+{
+    double power = 0;
+    for (unsigned int i = 0; i < deviceEntryVector.size(); i++)
+        if (deviceEntryVector[i]->currentActivity > -1 && deviceEntryVector[i]->draw > 0)
+            power += deviceEntryVector[i]->draw * voltage;
+    for (DeviceEntryMap::iterator it = deviceEntryMap.begin(); it != deviceEntryMap.end(); it++)
+        if (it->second->currentActivity > -1 && it->second->draw > 0)
+            power += it->second->draw * voltage;
+    return power;
+}
+
+simtime_t InetSimpleBattery::getLastPublishTime(simtime_t t)
+{
+    if (publishTime <= 0)
+        return -1;
+    double k = floor((t - publishStartTime) / publishTime);
+    simtime_t publishAt = publishStartTime + publishTime * k;
+    if (publishAt >= t)
+    {
+        k--;
+        publishAt -= publishTime;
+    }
+    return k >= 1 ? publishAt : SimTime(-1);
+}
+
+void InetSimpleBattery::scheduleNextUpdate()
+{
+    cancelEvent(timeout);
+    double power = getCurrentPower();
+    if (residualCapacity <= 0 || power <= 0)
+        return;
+
+    // the battery gets depleted
+    simtime_t now = simTime();
+    double depletionDelay = residualCapacity / power;
+    simtime_t next = now + depletionDelay;
+
+    // the capacity drops by publishDelta since the last publication; the
+    // (virtual) publish timer resets lastPublishCapacity periodically
+    double publishDrop = publishDelta * capacity;
+    double publishDelay = (residualCapacity - (lastPublishCapacity - publishDrop)) / power;
+    if (publishDelay < depletionDelay)
+    {
+        simtime_t publishAt = getLastPublishTime(now);
+        simtime_t nextPublishAt = -1;
+        if (publishTime > 0)
+        {
+            // the boundary at exactly now has not been applied yet
+            nextPublishAt = publishAt < 0 ? publishStartTime + publishTime : publishAt + publishTime;
+            if (nextPublishAt < now)
+                nextPublishAt += publishTime;
+        }
+        if (nextPublishAt < 0 || now + publishDelay <= nextPublishAt)
+            next = now + publishDelay;
+        else if (publishDrop / power <= publishTime.dbl())
+        {
+            // publishDelta is reached after a publish timer, but before the next one
+            simtime_t publishDeltaAt = nextPublishAt + publishDrop / power;
+            if (publishDeltaAt < next)
+                next = publishDeltaAt;
+        }
+    }
+
+    // round up, so that the threshold has surely been crossed when the timer fires
+    SimTime epsilon;
+    epsilon.setRaw(1);
+    if (next < now)
+        next = now;
+    scheduleAt(next + epsilon, timeout);
+}
+
+double InetSimpleBattery::getVoltage()
+{
+    return voltage;
+}
+
+double InetSimpleBattery::estimateResidualAbs()
+{
+    // the current draw is constant since the last update
+    double residual = residualCapacity;
+    if (resolution == 0 && residual > 0)
+        residual -= getCurrentPower() * (simTime() - lastUpdateTime).dbl();
+    return std::max(residual, 0.0);
+}
+
+double InetSimpleBattery::estimateResidualRelative()
+{
+    return estimateResidualAbs() / nominalCapacity;
+}
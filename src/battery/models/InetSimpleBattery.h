@@ -119,8 +119,26 @@ class INET_API InetSimpleBattery : public BasicBattery
     cMessage *publish;
     cMessage *timeout;
     simtime_t lastUpdateTime;
+    simtime_t publishStartTime;
 
     virtual void deductAndCheck();
+
+    /** @brief ends the simulation on depletion, or publishes the capacity if it dropped by publishDelta */
+    virtual void checkCapacity();
+
+    /** @brief total power (mW) currently drawn by the devices in CURRENT mode */
+    virtual double getCurrentPower();
+
+    /**
+     * @brief With resolution == 0: schedules the timeout at the next moment
+     * the residual capacity needs to be looked at, i.e. when the battery gets
+     * depleted or the capacity drops by publishDelta, assuming that the
+     * current draw does not change until then.
+     */
+    virtual void scheduleNextUpdate();
+
+    /** @brief the last publish time strictly before t, or -1 if there is none */
+    simtime_t getLastPublishTime(simtime_t t);
     void receiveChangeNotification(int aCategory, const cObject* aDetails);
 
 };
@@ -41,6 +41,7 @@ void EtherBus::initialize()
     WATCH(numMessages);
 
     propagationSpeed = par("propagationSpeed").doubleValue();
+    directTapDelivery = par("directTapDelivery").boolValue();
 
     // initialize the positions where the hosts connects to the bus
     numTaps = gateSize("ethg");
@@ -203,78 +204,143 @@ void EtherBus::handleMessage(cMessage *msg)
     if (dataratesDiffer)
         checkConnections(true);
 
-    if (!msg->isSelfMessage())
+    if (msg->isSelfMessage())
     {
-        // Handle frame sent down from the network entity
-        int tapPoint = msg->getArrivalGate()->getIndex();
-        EV << "Frame " << msg << " arrived on tap " << tapPoint << endl;
+        // frame travelling along the bus in hop-by-hop mode
+        propagateToNextTap(msg);
+        return;
+    }
 
-        // create upstream and downstream events
-        if (tapPoint > 0)
-        {
-            // start UPSTREAM travel
-            // if goes downstream too, we need to make a copy
-            cMessage *msg2 = (tapPoint < numTaps-1) ? msg->dup() : msg;
-            msg2->setKind(UPSTREAM);
-            msg2->setContextPointer(&tap[tapPoint-1]);
-            scheduleAt(simTime()+tap[tapPoint].propagationDelay[UPSTREAM], msg2);
-        }
+    // Handle frame sent down from the network entity
+    int tapPoint = msg->getArrivalGate()->getIndex();
+    EV << "Frame " << msg << " arrived on tap " << tapPoint << endl;
 
-        if (tapPoint < numTaps-1)
-        {
-            // start DOWNSTREAM travel
-            msg->setKind(DOWNSTREAM);
-            msg->setContextPointer(&tap[tapPoint+1]);
-            scheduleAt(simTime()+tap[tapPoint].propagationDelay[DOWNSTREAM], msg);
-        }
+    numMessages++;
 
-        if (numTaps == 1)
-        {
-            // if there's only one tap, there's nothing to do
-            delete msg;
-        }
-    }
+    if (directTapDelivery)
+        sendToAllTaps(msg, tapPoint);
     else
+        startPropagation(msg, tapPoint);
+}
+
+void EtherBus::startPropagation(cMessage *msg, int tapPoint)
+{
+    // create upstream and downstream events
+    if (tapPoint > 0)
+    {
+        // start UPSTREAM travel
+        // if goes downstream too, we need to make a copy
+        cMessage *msg2 = (tapPoint < numTaps-1) ? msg->dup() : msg;
+        msg2->setKind(UPSTREAM);
+        msg2->setContextPointer(&tap[tapPoint-1]);
+        scheduleAt(simTime()+tap[tapPoint].propagationDelay[UPSTREAM], msg2);
+    }
+
+    if (tapPoint < numTaps-1)
     {
-        // handle upstream and downstream events
-        int direction = msg->getKind();
-        BusTap *thistap = (BusTap *)msg->getContextPointer();
-        int tapPoint = thistap->id;
+        // start DOWNSTREAM travel
+        msg->setKind(DOWNSTREAM);
+        msg->setContextPointer(&tap[tapPoint+1]);
+        scheduleAt(simTime()+tap[tapPoint].propagationDelay[DOWNSTREAM], msg);
+    }
 
-        EV << "Event " << msg << " on tap " << tapPoint << ", sending out frame\n";
+    if (numTaps == 1)
+    {
+        // if there's only one tap, there's nothing to do
+        delete msg;
+    }
+}
 
-        // send out on gate
-        bool isLast = (direction == UPSTREAM) ? (tapPoint == 0) : (tapPoint == numTaps-1);
-        cGate* ogate = gate(outputGateBaseId + tapPoint);
-        if (ogate->isConnected())
-        {
-            // send out on gate
-            cMessage *msg2 = isLast ? msg : msg->dup();
+void EtherBus::propagateToNextTap(cMessage *msg)
+{
+    // handle upstream and downstream events
+    int direction = msg->getKind();
+    BusTap *thistap = (BusTap *)msg->getContextPointer();
+    int tapPoint = thistap->id;
 
-            // stop current transmission
-            ogate->getTransmissionChannel()->forceTransmissionFinishTime(SIMTIME_ZERO);
-            send(msg2, ogate);
-        }
-        else
-        {
-            // skip gate
-            if (isLast)
-                delete msg;
-        }
+    EV << "Event " << msg << " on tap " << tapPoint << ", sending out frame\n";
 
-        // if not end of the bus, schedule for next tap
+    // send out on gate
+    bool isLast = (direction == UPSTREAM) ? (tapPoint == 0) : (tapPoint == numTaps-1);
+    if (gate(outputGateBaseId + tapPoint)->isConnected())
+    {
+        // send out on gate
+        sendToTap(isLast ? msg : msg->dup(), tapPoint, SIMTIME_ZERO);
+    }
+    else
+    {
+        // skip gate
         if (isLast)
-        {
-            EV << "End of bus reached\n";
-        }
-        else
-        {
-            EV << "Scheduling for next tap\n";
-            int nextTap = (direction==UPSTREAM) ? (tapPoint-1) : (tapPoint+1);
-            msg->setContextPointer(&tap[nextTap]);
-            scheduleAt(simTime()+tap[tapPoint].propagationDelay[direction], msg);
-        }
+            delete msg;
     }
+
+    // if not end of the bus, schedule for next tap
+    if (isLast)
+    {
+        EV << "End of bus reached\n";
+    }
+    else
+    {
+        EV << "Scheduling for next tap\n";
+        int nextTap = (direction==UPSTREAM) ? (tapPoint-1) : (tapPoint+1);
+        msg->setContextPointer(&tap[nextTap]);
+        scheduleAt(simTime()+tap[tapPoint].propagationDelay[direction], msg);
+    }
+}
+
+void EtherBus::sendToAllTaps(cMessage *msg, int tapPoint)
+{
+    // Send the frame out on every other tap directly, delayed by the propagation
+    // time to that tap. This needs no per-tap events in the bus. Unconnected taps
+    // are skipped, and the frame itself is sent out on the last connected tap
+    // after all copies have been made, instead of being copied.
+    int lastTap = -1;
+    for (int i = numTaps-1; i >= 0 && lastTap == -1; i--)
+        if (i != tapPoint && gate(outputGateBaseId + i)->isConnected())
+            lastTap = i;
+
+    if (lastTap == -1)
+    {
+        // nobody else is connected to the bus
+        delete msg;
+        return;
+    }
+
+    simtime_t lastTapDelay = SIMTIME_ZERO;
+    simtime_t delay = SIMTIME_ZERO;
+    for (int i = tapPoint-1; i >= 0; i--)
+    {
+        delay += tap[i+1].propagationDelay[UPSTREAM];
+        if (i == lastTap)
+            lastTapDelay = delay;
+        else if (gate(outputGateBaseId + i)->isConnected())
+            sendToTap(msg->dup(), i, delay);
+    }
+    delay = SIMTIME_ZERO;
+    for (int i = tapPoint+1; i < numTaps; i++)
+    {
+        delay += tap[i-1].propagationDelay[DOWNSTREAM];
+        if (i == lastTap)
+            lastTapDelay = delay;
+        else if (gate(outputGateBaseId + i)->isConnected())
+            sendToTap(msg->dup(), i, delay);
+    }
+    sendToTap(msg, lastTap, lastTapDelay);
+}
+
+void EtherBus::sendToTap(cMessage *msg, int tapPoint, simtime_t delay)
+{
+    cGate *ogate = gate(outputGateBaseId + tapPoint);
+    ASSERT(ogate->isConnected());
+
+    EV << "Sending out frame " << msg << " on tap " << tapPoint << " after " << delay << "s\n";
+
+    // stop current transmission
+    ogate->getTransmissionChannel()->forceTransmissionFinishTime(SIMTIME_ZERO);
+    if (delay == SIMTIME_ZERO)
+        send(msg, ogate);
+    else
+        sendDelayed(msg, delay, ogate);
 }
 
 void EtherBus::finish()
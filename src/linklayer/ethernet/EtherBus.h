@@ -22,7 +22,7 @@
 
 #include "INETDefs.h"
 
-// Direction of frame travel on bus; also used as selfmessage kind
+// Direction of frame travel on bus; index into BusTap::propagationDelay
 #define UPSTREAM        0
 #define DOWNSTREAM      1
 
@@ -46,6 +46,7 @@ class INET_API EtherBus : public cSimpleModule, cListener
 
     // configuration
     double  propagationSpeed;  // propagation speed of electrical signals through copper
+    bool directTapDelivery;    // send to all taps at once instead of tap by tap
     BusTap *tap;   // array of BusTaps: physical locations taps where that connect stations to the bus
     int numTaps;   // number of tap points on the bus
     int inputGateBaseId;  // gate id of ethg$i[0]
@@ -68,6 +69,10 @@ class INET_API EtherBus : public cSimpleModule, cListener
     virtual void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj);
 
     virtual void checkConnections(bool errorWhenAsymmetric);
+    virtual void startPropagation(cMessage *msg, int tapPoint);
+    virtual void propagateToNextTap(cMessage *msg);
+    virtual void sendToAllTaps(cMessage *msg, int tapPoint);
+    virtual void sendToTap(cMessage *msg, int tapPoint, simtime_t delay);
 };
 
 #endif
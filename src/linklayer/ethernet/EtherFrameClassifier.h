@@ -21,6 +21,8 @@
 
 #include "INETDefs.h"
 
+#include "FusedModuleBase.h"
+
 /**
  * Ethernet Frame classifier.
  *
@@ -28,7 +30,7 @@
  * - PAUSE frames
  * - others
  */
-class INET_API EtherFrameClassifier : public cSimpleModule
+class INET_API EtherFrameClassifier : public FusedModuleBase
 {
   public:
     /**
@@ -0,0 +1,99 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <string.h>
+
+#include "ExtFrame.h"
+
+Register_Class(ExtFrame);
+
+void ExtFrame::copy(const ExtFrame& other)
+{
+    buffer = other.buffer;
+    if (buffer)
+        buffer->refCount++;
+}
+
+void ExtFrame::release()
+{
+    if (buffer && --buffer->refCount == 0)
+        delete buffer;
+    buffer = NULL;
+}
+
+void ExtFrame::makeWritable()
+{
+    if (!buffer)
+        buffer = new Buffer();
+    else if (buffer->refCount > 1)
+    {
+        Buffer *unique = new Buffer();
+        unique->bytes = buffer->bytes;
+        buffer->refCount--;
+        buffer = unique;
+    }
+}
+
+ExtFrame& ExtFrame::operator=(const ExtFrame& other)
+{
+    if (this == &other)
+        return *this;
+    ExtFrame_Base::operator=(other);
+    release();
+    copy(other);
+    return *this;
+}
+
+void ExtFrame::setDataArraySize(unsigned int size)
+{
+    makeWritable();
+    buffer->bytes.resize(size);
+}
+
+unsigned int ExtFrame::getDataArraySize() const
+{
+    return buffer ? buffer->bytes.size() : 0;
+}
+
+uint8 ExtFrame::getData(unsigned int k) const
+{
+    if (k >= getDataArraySize())
+        throw cRuntimeError("Array of size %d indexed by %d", getDataArraySize(), k);
+    return buffer->bytes[k];
+}
+
+void ExtFrame::setData(unsigned int k, uint8 data)
+{
+    if (k >= getDataArraySize())
+        throw cRuntimeError("Array of size %d indexed by %d", getDataArraySize(), k);
+    makeWritable();
+    buffer->bytes[k] = data;
+}
+
+void ExtFrame::assignData(const uint8 *data, unsigned int length)
+{
+    release();
+    buffer = new Buffer();
+    buffer->bytes.resize(length);
+    if (length > 0)
+        memcpy(&buffer->bytes[0], data, length);
+}
+
+const uint8 *ExtFrame::getDataPointer() const
+{
+    return getDataArraySize() > 0 ? &buffer->bytes[0] : NULL;
+}
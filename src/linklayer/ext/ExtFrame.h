@@ -0,0 +1,74 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __INET_EXTFRAME_H
+#define __INET_EXTFRAME_H
+
+#include <vector>
+
+#include "INETDefs.h"
+#include "ExtFrame_m.h"
+
+/**
+ * Represents a packet captured from a real network interface. More info in
+ * the ExtFrame.msg file (and the documentation generated from it).
+ *
+ * The data[] array is a contiguous buffer shared by copies of the frame and
+ * copied only when one of them is modified.
+ */
+class INET_API ExtFrame : public ExtFrame_Base
+{
+  protected:
+    struct Buffer
+    {
+        int refCount;
+        std::vector<uint8> bytes;
+        Buffer() : refCount(1) {}
+    };
+    Buffer *buffer;  // NULL if empty
+
+  private:
+    void copy(const ExtFrame& other);
+    void release();
+    void makeWritable();
+
+  public:
+    ExtFrame(const char *name = NULL, int kind = 0) : ExtFrame_Base(name, kind), buffer(NULL) {}
+    ExtFrame(const ExtFrame& other) : ExtFrame_Base(other), buffer(NULL) { copy(other); }
+    ~ExtFrame() { release(); }
+    ExtFrame& operator=(const ExtFrame& other);
+    virtual ExtFrame *dup() const {return new ExtFrame(*this);}
+
+    virtual void setDataArraySize(unsigned int size);
+    virtual unsigned int getDataArraySize() const;
+    virtual uint8 getData(unsigned int k) const;
+    virtual void setData(unsigned int k, uint8 data);
+
+    /**
+     * Replaces the contents of the frame with a copy of the given bytes.
+     */
+    virtual void assignData(const uint8 *data, unsigned int length);
+
+    /**
+     * Returns the getDataArraySize() bytes of the frame as a contiguous
+     * block, or NULL if the frame is empty. The pointer is invalidated
+     * by the next modification of the frame.
+     */
+    virtual const uint8 *getDataPointer() const;
+};
+
+#endif
@@ -106,16 +106,11 @@ void ExtInterface::handleMessage(cMessage *msg)
 
     if (dynamic_cast<ExtFrame *>(msg) != NULL)
     {
-        // incoming real packet from wire (captured by pcap)
-        uint32 packetLength;
+        // incoming real packet from wire (captured by pcap), parsed in place
         ExtFrame *rawPacket = check_and_cast<ExtFrame *>(msg);
 
-        packetLength = rawPacket->getDataArraySize();
-        for (uint32 i=0; i < packetLength; i++)
-            buffer[i] = rawPacket->getData(i);
-
         IPv4Datagram *ipPacket = new IPv4Datagram("ip-from-wire");
-        IPv4Serializer().parse(buffer, packetLength, (IPv4Datagram *)ipPacket);
+        IPv4Serializer().parse(rawPacket->getDataPointer(), rawPacket->getDataArraySize(), ipPacket);
         EV << "Delivering an IPv4 packet from "
            << ipPacket->getSrcAddress()
            << " to "
@@ -128,7 +123,6 @@ void ExtInterface::handleMessage(cMessage *msg)
     }
     else
     {
-        memset(buffer, 0, sizeof(buffer));
         IPv4Datagram *ipPacket = check_and_cast<IPv4Datagram *>(msg);
 
         if ((ipPacket->getTransportProtocol() != IP_PROT_ICMP) &&
@@ -151,7 +145,9 @@ void ExtInterface::handleMessage(cMessage *msg)
 #endif
             addr.sin_port = 0;
             addr.sin_addr.s_addr = htonl(ipPacket->getDestAddress().getInt());
-            int32 packetLength = IPv4Serializer().serialize(ipPacket, buffer, sizeof(buffer));
+            size_t bufferSize;
+            uint8 *buffer = rtScheduler->getSendBuffer(bufferSize);
+            int32 packetLength = IPv4Serializer().serialize(ipPacket, buffer, bufferSize);
             EV << "Delivering an IPv4 packet from "
                << ipPacket->getSrcAddress()
                << " to "
@@ -159,7 +155,7 @@ void ExtInterface::handleMessage(cMessage *msg)
                << " and length of "
                << ipPacket->getByteLength()
                << " bytes to link layer.\n";
-            rtScheduler->sendBytes(buffer, packetLength, (struct sockaddr *) &addr, sizeof(struct sockaddr_in));
+            rtScheduler->sendBuffer(packetLength, (struct sockaddr *) &addr, sizeof(struct sockaddr_in));
             numSent++;
         }
         else
@@ -29,7 +29,7 @@
 #include "INETDefs.h"
 
 #include "MACBase.h"
-#include "ExtFrame_m.h"
+#include "ExtFrame.h"
 #include "cSocketRTScheduler.h"
 
 // Forward declarations:
@@ -49,7 +49,6 @@ class ExtInterface : public MACBase
 {
   protected:
     bool connected;
-    uint8 buffer[1<<16];
     const char *device;
 
     // statistics
@@ -47,6 +47,9 @@ timeval cSocketRTScheduler::baseTime;
 
 Register_Class(cSocketRTScheduler);
 
+Register_GlobalConfigOption(CFGID_SOCKETRTSCHEDULER_SEND_BATCH_SIZE, "socketrtscheduler-send-batch-size", CFG_INT, "32", "The maximum number of outgoing packets cSocketRTScheduler collects before sending them with one system call. Pending packets are also sent whenever the scheduler waits for the wall clock, so batching adds no delay when the simulation keeps up with real time. When it is behind, packets are held back at most for socketrtscheduler-send-max-delay. 1 sends every packet immediately.");
+Register_GlobalConfigOptionU(CFGID_SOCKETRTSCHEDULER_SEND_MAX_DELAY, "socketrtscheduler-send-max-delay", "s", "1ms", "The maximum wall clock time cSocketRTScheduler holds back an outgoing packet for batching while the simulation is behind real time. See socketrtscheduler-send-batch-size.");
+
 inline std::ostream& operator<<(std::ostream& out, const timeval& tv)
 {
     return out << (uint32)tv.tv_sec << "s" << tv.tv_usec << "us";
@@ -56,6 +59,9 @@ inline std::ostream& operator<<(std::ostream& out, const timeval& tv)
 cSocketRTScheduler::cSocketRTScheduler() : cScheduler()
 {
     fd = INVALID_SOCKET;
+    sendBatchSize = 1;
+    sendMaxDelayUsec = 0;
+    numPendingSends = 0;
 }
 
 cSocketRTScheduler::~cSocketRTScheduler()
@@ -66,6 +72,20 @@ void cSocketRTScheduler::startRun()
 {
     gettimeofday(&baseTime, NULL);
 
+    sendBatchSize = ev.getConfig()->getAsInt(CFGID_SOCKETRTSCHEDULER_SEND_BATCH_SIZE);
+    if (sendBatchSize < 1)
+        throw cRuntimeError("cSocketRTScheduler: socketrtscheduler-send-batch-size must be at least 1");
+    sendMaxDelayUsec = (long)(ev.getConfig()->getAsDouble(CFGID_SOCKETRTSCHEDULER_SEND_MAX_DELAY) * 1e6);
+    numPendingSends = 0;
+    sendBuffers.assign(sendBatchSize * SEND_BUFFER_SIZE, 0);
+    sendLengths.assign(sendBatchSize, 0);
+    sendAddrs.resize(sendBatchSize);
+    sendAddrLengths.resize(sendBatchSize);
+#ifdef HAVE_SENDMMSG
+    sendIovecs.resize(sendBatchSize);
+    sendMsgHeaders.resize(sendBatchSize);
+#endif
+
 #ifdef HAVE_PCAP
     // Enabling sending makes no sense when we can't receive...
     fd = socket(AF_INET, SOCK_RAW, IPPROTO_RAW);
@@ -80,6 +100,8 @@ void cSocketRTScheduler::startRun()
 
 void cSocketRTScheduler::endRun()
 {
+    if (fd != INVALID_SOCKET)
+        flushSends();
     close(fd);
     fd = INVALID_SOCKET;
 
@@ -199,11 +221,10 @@ static void packet_handler(u_char *user, const struct pcap_pkthdr *hdr, const u_
             return;
     }
 
-    // put the IP packet from wire into data[] array of ExtFrame
+    // put the IP packet from wire into data[] array of ExtFrame; the
+    // pcap buffer is only valid during this call, so it's copied once
     ExtFrame *notificationMsg = new ExtFrame("rtEvent");
-    notificationMsg->setDataArraySize(hdr->caplen - headerLength);
-    for (uint16 j=0; j < hdr->caplen - headerLength; j++)
-        notificationMsg->setData(j, bytes[j + headerLength]);
+    notificationMsg->assignData(bytes + headerLength, hdr->caplen - headerLength);
 
     // signalize new incoming packet to the interface via cMessage
     EV << "Captured " << hdr->caplen - headerLength << " bytes for an IP packet.\n";
@@ -326,6 +347,9 @@ cMessage *cSocketRTScheduler::getNextEvent()
     gettimeofday(&curTime, NULL);
     if (timeval_greater(targetTime, curTime))
     {
+        // we're idle until then, so send what has been collected so far
+        if (numPendingSends > 0)
+            flushSends();
         int status = receiveUntil(targetTime);
         if (status == -1)
             return NULL; // interrupted by user
@@ -338,6 +362,10 @@ cMessage *cSocketRTScheduler::getNextEvent()
         // alert if we're too much behind, whatever that means
         timeval diffTime = timeval_substract(curTime, targetTime);
         EV << "We are behind: " << diffTime.tv_sec + diffTime.tv_usec * 1e-6 << " seconds\n";
+
+        // we may stay behind for long, so do not hold back packets forever
+        if (numPendingSends > 0 && timeval_diff_usec(curTime, firstPendingSendTime) >= sendMaxDelayUsec)
+            flushSends();
     }
     cEvent *tmp = sim->msgQueue.removeFirst();
     ASSERT(tmp == event);
@@ -353,14 +381,91 @@ void cSocketRTScheduler::putBackEvent(cEvent *event)
 #endif
 
 void cSocketRTScheduler::sendBytes(uint8 *buf, size_t numBytes, struct sockaddr *to, socklen_t addrlen)
+{
+    size_t bufferSize;
+    uint8 *sendBuf = getSendBuffer(bufferSize);
+    if (numBytes > bufferSize)
+        throw cRuntimeError("cSocketRTScheduler::sendBytes(): packet of %d bytes is too long", (int)numBytes);
+    memcpy(sendBuf, buf, numBytes);
+    sendBuffer(numBytes, to, addrlen);
+}
+
+uint8 *cSocketRTScheduler::getSendBuffer(size_t& bufferSize)
 {
     if (fd == INVALID_SOCKET)
-        throw cRuntimeError("cSocketRTScheduler::sendBytes(): no raw socket.");
+        throw cRuntimeError("cSocketRTScheduler::getSendBuffer(): no raw socket.");
+
+    // only the bytes used by the previous packet in this slot need to be cleared;
+    // until sendBuffer() is called, assume the whole slot will be written
+    uint8 *buf = &sendBuffers[numPendingSends * SEND_BUFFER_SIZE];
+    memset(buf, 0, sendLengths[numPendingSends]);
+    sendLengths[numPendingSends] = SEND_BUFFER_SIZE;
+    bufferSize = SEND_BUFFER_SIZE;
+    return buf;
+}
 
-    int sent = sendto(fd, (char *)buf, numBytes, 0, to, addrlen);  //note: no ssize_t on MSVC
+void cSocketRTScheduler::sendBuffer(size_t numBytes, struct sockaddr *to, socklen_t addrlen)
+{
+    if (numBytes > SEND_BUFFER_SIZE)
+        throw cRuntimeError("cSocketRTScheduler::sendBuffer(): packet of %d bytes is too long", (int)numBytes);
+    if (addrlen > (socklen_t)sizeof(struct sockaddr_in))
+        throw cRuntimeError("cSocketRTScheduler::sendBuffer(): unsupported address length %d", (int)addrlen);
+
+    sendLengths[numPendingSends] = numBytes;
+    memcpy(&sendAddrs[numPendingSends], to, addrlen);
+    sendAddrLengths[numPendingSends] = addrlen;
+    if (numPendingSends == 0)
+        gettimeofday(&firstPendingSendTime, NULL);
+    numPendingSends++;
+    if (numPendingSends == sendBatchSize)
+        flushSends();
+}
 
-    if ((size_t)sent == numBytes)
-        EV << "Sent an IP packet with length of " << sent << " bytes.\n";
-    else
-        EV << "Sending of an IP packet FAILED! (sendto returned " << sent << " (" << strerror(errno) << ") instead of " << numBytes << ").\n";
+void cSocketRTScheduler::flushSends()
+{
+#ifdef HAVE_SENDMMSG
+    for (int i = 0; i < numPendingSends; i++)
+    {
+        sendIovecs[i].iov_base = &sendBuffers[i * SEND_BUFFER_SIZE];
+        sendIovecs[i].iov_len = sendLengths[i];
+        memset(&sendMsgHeaders[i], 0, sizeof(struct mmsghdr));
+        sendMsgHeaders[i].msg_hdr.msg_name = &sendAddrs[i];
+        sendMsgHeaders[i].msg_hdr.msg_namelen = sendAddrLengths[i];
+        sendMsgHeaders[i].msg_hdr.msg_iov = &sendIovecs[i];
+        sendMsgHeaders[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int i = 0;
+    while (i < numPendingSends)
+    {
+        int n = sendmmsg(fd, &sendMsgHeaders[i], numPendingSends - i, 0);
+        if (n <= 0)
+        {
+            // the packet at i could not be sent; skip it and go on with the rest
+            EV << "Sending of an IP packet FAILED! (sendmmsg returned " << n << " (" << strerror(errno) << ") instead of " << sendLengths[i] << ").\n";
+            i++;
+            continue;
+        }
+        for (int j = i; j < i + n; j++)
+        {
+            if (sendMsgHeaders[j].msg_len == sendLengths[j])
+                EV << "Sent an IP packet with length of " << sendMsgHeaders[j].msg_len << " bytes.\n";
+            else
+                EV << "Sending of an IP packet FAILED! (sent " << sendMsgHeaders[j].msg_len << " instead of " << sendLengths[j] << " bytes).\n";
+        }
+        i += n;
+    }
+#else
+    for (int i = 0; i < numPendingSends; i++)
+    {
+        size_t numBytes = sendLengths[i];
+        int sent = sendto(fd, (char *)&sendBuffers[i * SEND_BUFFER_SIZE], numBytes, 0, (struct sockaddr *)&sendAddrs[i], sendAddrLengths[i]);  //note: no ssize_t on MSVC
+
+        if ((size_t)sent == numBytes)
+            EV << "Sent an IP packet with length of " << sent << " bytes.\n";
+        else
+            EV << "Sending of an IP packet FAILED! (sendto returned " << sent << " (" << strerror(errno) << ") instead of " << numBytes << ").\n";
+    }
+#endif
+    numPendingSends = 0;
 }
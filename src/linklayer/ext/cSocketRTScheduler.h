@@ -34,13 +34,35 @@
 #ifdef HAVE_PCAP
 #include <pcap.h>
 #endif
-#include "ExtFrame_m.h"
+#include "ExtFrame.h"
+
+// sendmmsg() is available from glibc 2.14
+#if defined(__linux__) && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14))
+#define HAVE_SENDMMSG
+#endif
+
+#define SEND_BUFFER_SIZE (1<<16)
 
 class cSocketRTScheduler : public cScheduler
 {
     protected:
         int fd;
 
+        // outgoing packets collected for one sendmmsg() call; slot i of
+        // sendBuffers starts at i*SEND_BUFFER_SIZE
+        int sendBatchSize;
+        long sendMaxDelayUsec;          // wall clock time a packet may be held back while the simulation is behind
+        int numPendingSends;
+        timeval firstPendingSendTime;   // when the oldest pending packet was queued
+        std::vector<uint8> sendBuffers;
+        std::vector<size_t> sendLengths;
+        std::vector<struct sockaddr_in> sendAddrs;
+        std::vector<socklen_t> sendAddrLengths;
+#ifdef HAVE_SENDMMSG
+        std::vector<struct iovec> sendIovecs;
+        std::vector<struct mmsghdr> sendMsgHeaders;
+#endif
+
         virtual bool receiveWithTimeout(long usec);
         virtual int receiveUntil(const timeval& targetTime);
     public:
@@ -109,6 +131,27 @@ class cSocketRTScheduler : public cScheduler
          * Send on the currently open connection
          */
         void sendBytes(unsigned char *buf, size_t numBytes, struct sockaddr *from, socklen_t addrlen);
+
+        /**
+         * Returns a zeroed buffer of bufferSize bytes to serialize the next
+         * outgoing packet into, to be passed to sendBuffer(). This saves
+         * the copy done by sendBytes().
+         */
+        uint8 *getSendBuffer(size_t& bufferSize);
+
+        /**
+         * Sends the first numBytes bytes of the buffer returned by the last
+         * getSendBuffer() call. The packet may be held back to be sent
+         * together with others, until the scheduler next waits for the
+         * wall clock, socketrtscheduler-send-batch-size packets are pending,
+         * or it has been held back for socketrtscheduler-send-max-delay.
+         */
+        void sendBuffer(size_t numBytes, struct sockaddr *to, socklen_t addrlen);
+
+        /**
+         * Sends the packets held back by sendBuffer().
+         */
+        virtual void flushSends();
 };
 
 #endif
@@ -22,7 +22,7 @@
 #include "IInterfaceTable.h"
 #include "InterfaceTableAccess.h"
 #include "PhyControlInfo_m.h"
-#include "AirFrame_m.h"
+#include "AirFrame.h"
 #include "Radio80211aControlInfo_m.h"
 #include "Ieee80211eClassifier.h"
 #include "Ieee80211DataRate.h"
@@ -64,6 +64,7 @@ Ieee80211Mac::Ieee80211Mac()
     endTimeout = NULL;
     endReserve = NULL;
     mediumStateChange = NULL;
+    contentionTimer = NULL;
     pendingRadioConfigMsg = NULL;
     classifier = NULL;
 }
@@ -75,6 +76,7 @@ Ieee80211Mac::~Ieee80211Mac()
     cancelAndDelete(endTimeout);
     cancelAndDelete(endReserve);
     cancelAndDelete(mediumStateChange);
+    cancelAndDelete(contentionTimer);
     cancelAndDelete(endTXOP);
     for (unsigned int i = 0; i < edcCAF.size(); i++)
     {
@@ -297,6 +299,10 @@ void Ieee80211Mac::initialize(int stage)
         endTimeout = new cMessage("Timeout");
         endReserve = new cMessage("Reserve");
         mediumStateChange = new cMessage("MediumStateChange");
+        contentionTimer = new cMessage("Contention");
+        useContentionEngine = par("useContentionEngine");
+        lastContentionSequence = 0;
+        numContentionTimerReschedules = 0;
 
         // interface
         if (isInterfaceRegistered().isUnspecified()) //TODO do we need multi-MAC feature? if so, should they share interfaceEntry??  --Andras
@@ -420,6 +426,7 @@ void Ieee80211Mac::initWatches()
      WATCH(numReceived);
      WATCH(numSentMulticast);
      WATCH(numReceivedMulticast);
+     WATCH(numContentionTimerReschedules);
      for (int i=0; i<numCategories(); i++)
          WATCH(edcCAF[i].numDropped);
      if (throughputTimer)
@@ -551,6 +558,15 @@ void Ieee80211Mac::handleSelfMsg(cMessage *msg)
         return;
     }
 
+    if (msg == contentionTimer)
+    {
+        // the contention engine delivers the timer that won
+        msg = findContentionWinner();
+        ASSERT(msg != NULL && getContentionTimerArrivalTime(msg) == simTime());
+        getContentionTimerState(msg)->scheduled = false;
+        updateContentionTimer();
+    }
+
     EV << "received self message: " << msg << "(kind: " << msg->getKind() << ")" << endl;
 
     if (msg == endReserve)
@@ -574,14 +590,14 @@ void Ieee80211Mac::handleSelfMsg(cMessage *msg)
         EV <<" kind is " << kind << ",name is " << msg->getName() <<endl;
         for (unsigned int i = numCategories()-1; (int)i > kind; i--)  //mozna prochaze jen 3..kind XXX
         {
-            if (((endBackoff(i)->isScheduled() && endBackoff(i)->getArrivalTime() == simTime())
-                    || (endAIFS(i)->isScheduled() && !backoff(i) && endAIFS(i)->getArrivalTime() == simTime()))
+            if (((isContentionTimerScheduled(endBackoff(i)) && getContentionTimerArrivalTime(endBackoff(i)) == simTime())
+                    || (isContentionTimerScheduled(endAIFS(i)) && !backoff(i) && getContentionTimerArrivalTime(endAIFS(i)) == simTime()))
                     && !transmissionQueue(i)->empty())
             {
                 EV << "Internal collision AC" << kind << " with AC" << i << endl;
                 numInternalCollision++;
                 EV << "Cancel backoff event and schedule new one for AC" << kind << endl;
-                cancelEvent(endBackoff(kind));
+                cancelContentionTimer(endBackoff(kind));
                 if (retryCounter() == transmissionLimit - 1)
                 {
                     EV << "give up transmission for AC" << currentAC << endl;
@@ -875,18 +891,18 @@ void Ieee80211Mac::handleWithFSM(cMessage *msg)
             // a difs was schedule because all queues ware empty
             // change difs for aifs
             simtime_t remaint = getAIFS(currentAC)-getDIFS();
-            scheduleAt(endDIFS->getArrivalTime()+remaint, endAIFS(currentAC));
+            scheduleContentionTimer(endDIFS->getArrivalTime()+remaint, endAIFS(currentAC));
             cancelEvent(endDIFS);
         }
-        else if (fsm.getState() == BACKOFF && endBackoff(numCategories()-1)->isScheduled() &&  transmissionQueue(numCategories()-1)->empty())
+        else if (fsm.getState() == BACKOFF && isContentionTimerScheduled(endBackoff(numCategories()-1)) &&  transmissionQueue(numCategories()-1)->empty())
         {
             // a backoff was schedule with all the queues empty
             // reschedule the backoff with the appropriate AC
             backoffPeriod(currentAC) = backoffPeriod(numCategories()-1);
             backoff(currentAC) = backoff(numCategories()-1);
             backoff(numCategories()-1) = false;
-            scheduleAt(endBackoff(numCategories()-1)->getArrivalTime(), endBackoff(currentAC));
-            cancelEvent(endBackoff(numCategories()-1));
+            scheduleContentionTimer(getContentionTimerArrivalTime(endBackoff(numCategories()-1)), endBackoff(currentAC));
+            cancelContentionTimer(endBackoff(numCategories()-1));
         }
         EV << "deferring upper message transmission in " << fsm.getStateName() << " state\n";
         return;
@@ -1042,7 +1058,7 @@ void Ieee80211Mac::handleWithFSM(cMessage *msg)
                                   DEFER,
                                   for (int i=0; i<numCategories(); i++)
                                   {
-                                      if (endAIFS(i)->isScheduled())
+                                      if (isContentionTimerScheduled(endAIFS(i)))
                                           backoff(i) = true;
                                   }
                                   if (endDIFS->isScheduled()) backoff(numCategories()-1) = true;
@@ -1053,7 +1069,7 @@ void Ieee80211Mac::handleWithFSM(cMessage *msg)
                                      DEFER,
                                      for (int i=0; i<numCategories(); i++)
                                      {
-                                         if (endAIFS(i)->isScheduled())
+                                         if (isContentionTimerScheduled(endAIFS(i)))
                                              backoff(i) = true;
                                      }
                                      if (endDIFS->isScheduled()) backoff(numCategories()-1) = true;
@@ -1591,22 +1607,22 @@ void Ieee80211Mac::scheduleAIFSPeriod()
     bool schedule = false;
     for (int i = 0; i<numCategories(); i++)
     {
-        if (!endAIFS(i)->isScheduled() && !transmissionQueue(i)->empty())
+        if (!isContentionTimerScheduled(endAIFS(i)) && !transmissionQueue(i)->empty())
         {
 
             if (lastReceiveFailed)
             {
                 EV << "reception of last frame failed, scheduling EIFS-DIFS+AIFS period (" << i << ")\n";
-                scheduleAt(simTime() + getEIFS() - getDIFS() + getAIFS(i), endAIFS(i));
+                scheduleContentionTimer(simTime() + getEIFS() - getDIFS() + getAIFS(i), endAIFS(i));
             }
             else
             {
                 EV << "scheduling AIFS period (" << i << ")\n";
-                scheduleAt(simTime() + getAIFS(i), endAIFS(i));
+                scheduleContentionTimer(simTime() + getAIFS(i), endAIFS(i));
             }
 
         }
-        if (endAIFS(i)->isScheduled())
+        if (isContentionTimerScheduled(endAIFS(i)))
             schedule = true;
     }
     if (!schedule && !endDIFS->isScheduled())
@@ -1621,15 +1637,15 @@ void Ieee80211Mac::rescheduleAIFSPeriod(int AccessCategory)
 {
     ASSERT(1);
     EV << "rescheduling AIFS[" << AccessCategory << "]\n";
-    cancelEvent(endAIFS(AccessCategory));
-    scheduleAt(simTime() + getAIFS(AccessCategory), endAIFS(AccessCategory));
+    cancelContentionTimer(endAIFS(AccessCategory));
+    scheduleContentionTimer(simTime() + getAIFS(AccessCategory), endAIFS(AccessCategory));
 }
 
 void Ieee80211Mac::cancelAIFSPeriod()
 {
     EV << "canceling AIFS period\n";
     for (int i = 0; i<numCategories(); i++)
-        cancelEvent(endAIFS(i));
+        cancelContentionTimer(endAIFS(i));
     cancelEvent(endDIFS);
 }
 
@@ -1750,15 +1766,15 @@ void Ieee80211Mac::decreaseBackoffPeriod()
     // cancel event endBackoff after decrease or we don't know which endBackoff is scheduled
     for (int i = 0; i<numCategories(); i++)
     {
-        if (backoff(i) && endBackoff(i)->isScheduled())
+        if (backoff(i) && isContentionTimerScheduled(endBackoff(i)))
         {
-            EV<< "old backoff[" << i << "] is " << backoffPeriod(i) << ", sim time is " << simTime()
-            << ", endbackoff sending period is " << endBackoff(i)->getSendingTime() << endl;
-            simtime_t elapsedBackoffTime = simTime() - endBackoff(i)->getSendingTime();
+            EV_DEBUG << "old backoff[" << i << "] is " << backoffPeriod(i) << ", sim time is " << simTime()
+                     << ", endbackoff sending period is " << getContentionTimerSendingTime(endBackoff(i)) << endl;
+            simtime_t elapsedBackoffTime = simTime() - getContentionTimerSendingTime(endBackoff(i));
             backoffPeriod(i) -= ((int)(elapsedBackoffTime / getSlotTime())) * getSlotTime();
-            EV << "actual backoff[" << i << "] is " <<backoffPeriod(i) << ", elapsed is " << elapsedBackoffTime << endl;
+            EV_DEBUG << "actual backoff[" << i << "] is " << backoffPeriod(i) << ", elapsed is " << elapsedBackoffTime << endl;
             ASSERT(backoffPeriod(i) >= SIMTIME_ZERO);
-            EV << "backoff[" << i << "] period decreased to " << backoffPeriod(i) << endl;
+            EV_DEBUG << "backoff[" << i << "] period decreased to " << backoffPeriod(i) << endl;
         }
     }
 }
@@ -1766,14 +1782,120 @@ void Ieee80211Mac::decreaseBackoffPeriod()
 void Ieee80211Mac::scheduleBackoffPeriod()
 {
     EV << "scheduling backoff period\n";
-    scheduleAt(simTime() + backoffPeriod(), endBackoff());
+    scheduleContentionTimer(simTime() + backoffPeriod(), endBackoff());
 }
 
 void Ieee80211Mac::cancelBackoffPeriod()
 {
     EV << "cancelling Backoff period - only if some is scheduled\n";
     for (int i = 0; i<numCategories(); i++)
-        cancelEvent(endBackoff(i));
+        cancelContentionTimer(endBackoff(i));
+}
+
+/****************************************************************
+ * Contention engine.
+ */
+Ieee80211Mac::ContentionTimer *Ieee80211Mac::getContentionTimerState(cMessage *timer)
+{
+    int i = timer->getKind();
+    ASSERT(i >= 0 && i < numCategories());
+    if (timer == edcCAF[i].endAIFS)
+        return &edcCAF[i].aifsTimer;
+    ASSERT(timer == edcCAF[i].endBackoff);
+    return &edcCAF[i].backoffTimer;
+}
+
+void Ieee80211Mac::scheduleContentionTimer(simtime_t t, cMessage *timer)
+{
+    if (!useContentionEngine)
+    {
+        scheduleAt(t, timer);
+        return;
+    }
+    ContentionTimer *state = getContentionTimerState(timer);
+    if (state->scheduled)
+        throw cRuntimeError("scheduleContentionTimer(): timer (%s)%s is already scheduled", timer->getClassName(), timer->getName());
+    if (t < simTime())
+        throw cRuntimeError("scheduleContentionTimer(): cannot schedule timer (%s)%s into the past", timer->getClassName(), timer->getName());
+    state->scheduled = true;
+    state->arrivalTime = t;
+    state->sendingTime = simTime();
+    state->sequence = ++lastContentionSequence;
+    updateContentionTimer();
+}
+
+void Ieee80211Mac::cancelContentionTimer(cMessage *timer)
+{
+    if (!useContentionEngine)
+    {
+        cancelEvent(timer);
+        return;
+    }
+    ContentionTimer *state = getContentionTimerState(timer);
+    if (state->scheduled)
+    {
+        state->scheduled = false;
+        updateContentionTimer();
+    }
+}
+
+bool Ieee80211Mac::isContentionTimerScheduled(cMessage *timer)
+{
+    return useContentionEngine ? getContentionTimerState(timer)->scheduled : timer->isScheduled();
+}
+
+simtime_t Ieee80211Mac::getContentionTimerArrivalTime(cMessage *timer)
+{
+    return useContentionEngine ? getContentionTimerState(timer)->arrivalTime : timer->getArrivalTime();
+}
+
+simtime_t Ieee80211Mac::getContentionTimerSendingTime(cMessage *timer)
+{
+    return useContentionEngine ? getContentionTimerState(timer)->sendingTime : timer->getSendingTime();
+}
+
+cMessage *Ieee80211Mac::findContentionWinner()
+{
+    // timers expiring at the same time are delivered in scheduling order, like from the FES
+    cMessage *winner = NULL;
+    const ContentionTimer *winnerState = NULL;
+    for (int i = 0; i < numCategories(); i++)
+    {
+        const Edca& edca = edcCAF[i];
+        const ContentionTimer *states[2] = { &edca.aifsTimer, &edca.backoffTimer };
+        cMessage *timers[2] = { edca.endAIFS, edca.endBackoff };
+        for (int j = 0; j < 2; j++)
+        {
+            const ContentionTimer *state = states[j];
+            if (state->scheduled && (!winnerState || state->arrivalTime < winnerState->arrivalTime ||
+                    (state->arrivalTime == winnerState->arrivalTime && state->sequence < winnerState->sequence)))
+            {
+                winner = timers[j];
+                winnerState = state;
+            }
+        }
+    }
+    return winner;
+}
+
+void Ieee80211Mac::updateContentionTimer()
+{
+    cMessage *winner = findContentionWinner();
+    if (!winner)
+    {
+        if (contentionTimer->isScheduled())
+            cancelEvent(contentionTimer);
+        return;
+    }
+    simtime_t arrivalTime = getContentionTimerState(winner)->arrivalTime;
+    if (contentionTimer->isScheduled())
+    {
+        if (contentionTimer->getArrivalTime() == arrivalTime)
+            return;
+        cancelEvent(contentionTimer);
+    }
+    numContentionTimerReschedules++;
+    scheduleAt(arrivalTime, contentionTimer);
 }
 
 /****************************************************************
@@ -2211,10 +2333,10 @@ void Ieee80211Mac::logState()
         EV << " " << transmissionQueue(i)->size();
     EV << ", medium is " << (isMediumFree() ? "free" : "busy") << ", scheduled AIFS are";
     for (int i=0; i<numCategs; i++)
-        EV << " " << i << "(" << (edcCAF[i].endAIFS->isScheduled() ? "scheduled" : "") << ")";
+        EV << " " << i << "(" << (isContentionTimerScheduled(edcCAF[i].endAIFS) ? "scheduled" : "") << ")";
     EV << ", scheduled backoff are";
     for (int i=0; i<numCategs; i++)
-        EV << " " << i << "(" << (edcCAF[i].endBackoff->isScheduled() ? "scheduled" : "") << ")";
+        EV << " " << i << "(" << (isContentionTimerScheduled(edcCAF[i].endBackoff) ? "scheduled" : "") << ")";
     EV << "\n# currentAC: " << currentAC << ", oldcurrentAC: " << oldcurrentAC;
     if (getCurrentTransmission() != NULL)
         EV << "\n# current transmission: " << getCurrentTransmission()->getId();
@@ -208,6 +208,18 @@ class INET_API Ieee80211Mac : public WirelessMacBase
   protected:
     cFSM fsm;
 
+    /**
+     * State of an endAIFS or endBackoff timer while it is kept by the
+     * contention engine instead of the FES, see useContentionEngine.
+     */
+    struct ContentionTimer {
+        bool scheduled;
+        simtime_t arrivalTime;
+        simtime_t sendingTime;
+        long sequence;  // scheduling order, breaks ties between timers expiring at the same time
+        ContentionTimer() : scheduled(false), sequence(0) {}
+    };
+
     struct Edca {
         simtime_t TXOP;
         bool backoff;
@@ -221,6 +233,8 @@ class INET_API Ieee80211Mac : public WirelessMacBase
         // per class timers
         cMessage *endAIFS;
         cMessage *endBackoff;
+        ContentionTimer aifsTimer;
+        ContentionTimer backoffTimer;
         /** @name Statistics per Access Class*/
         //@{
         long numRetry;
@@ -392,6 +406,20 @@ class INET_API Ieee80211Mac : public WirelessMacBase
 
     /** Radio state change self message. Currently this is optimized away and sent directly */
     cMessage *mediumStateChange;
+
+    /**
+     * The only self-message in the FES for the endAIFS and endBackoff timers
+     * of all access categories when the contention engine is used; it is
+     * scheduled for the earliest of them, see updateContentionTimer().
+     */
+    cMessage *contentionTimer;
+    //@}
+
+    /** @name Contention engine */
+    //@{
+    bool useContentionEngine;
+    long lastContentionSequence;
+    long numContentionTimerReschedules;
     //@}
 
   protected:
@@ -524,6 +552,28 @@ class INET_API Ieee80211Mac : public WirelessMacBase
     virtual void finishReception();
     //@}
 
+    /**
+     * @name Contention engine
+     * @brief The endAIFS and endBackoff timers of all access categories are
+     * scheduled, cancelled and queried through these functions. If the
+     * contention engine is enabled, the timers are not inserted into the FES;
+     * only contentionTimer is, for the earliest expiry among all EDCAFs, and
+     * it is replaced by that timer when it arrives. Otherwise they are plain
+     * self-messages.
+     */
+    //@{
+    virtual ContentionTimer *getContentionTimerState(cMessage *timer);
+    virtual void scheduleContentionTimer(simtime_t t, cMessage *timer);
+    virtual void cancelContentionTimer(cMessage *timer);
+    virtual bool isContentionTimerScheduled(cMessage *timer);
+    virtual simtime_t getContentionTimerArrivalTime(cMessage *timer);
+    virtual simtime_t getContentionTimerSendingTime(cMessage *timer);
+    /** @brief Returns the endAIFS or endBackoff timer that expires first, or NULL. */
+    virtual cMessage *findContentionWinner();
+    /** @brief Schedules contentionTimer for the current winner, if that changed. */
+    virtual void updateContentionTimer();
+    //@}
+
   protected:
     /**
      * @name Frame transmission functions
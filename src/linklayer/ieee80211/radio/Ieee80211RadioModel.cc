@@ -138,7 +138,7 @@ PhyIndication Ieee80211RadioModel::isReceivedCorrectly(AirFrame *airframe, const
             snirMin = iter->snr;
 
     cPacket *frame = airframe->getEncapsulatedPacket();
-    EV << "packet (" << frame->getClassName() << ")" << frame->getName() << " (" << frame->info() << ") snrMin=" << snirMin << endl;
+    EV_DEBUG << "packet (" << frame->getClassName() << ")" << frame->getName() << " (" << frame->info() << ") snrMin=" << snirMin << endl;
 
     if (i%1000==0)
     {
@@ -20,12 +20,13 @@
 #define __INET_ALGORITHMICDROPPERBASE_H_
 
 #include "INETDefs.h"
+#include "FusedModuleBase.h"
 #include "IQueueAccess.h"
 
 /**
  * Base class for algorithmic droppers (RED, DropTail, etc.).
  */
-class INET_API AlgorithmicDropperBase : public cSimpleModule, public IQueueAccess
+class INET_API AlgorithmicDropperBase : public FusedModuleBase, public IQueueAccess
 {
     protected:
       int numGates;
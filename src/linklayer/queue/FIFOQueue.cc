@@ -55,7 +55,7 @@ cMessage *FIFOQueue::dequeue()
 
 void FIFOQueue::sendOut(cMessage *msg)
 {
-    send(msg, outGate);
+    sendFused(msg, outGate);
 }
 
 bool FIFOQueue::isEmpty()
@@ -20,6 +20,7 @@
 #define SCHEDULERBASE_H_
 
 #include "INETDefs.h"
+#include "FusedModuleBase.h"
 #include "IPassiveQueue.h"
 
 /**
@@ -35,7 +36,7 @@
  * at one of their inputs without dequeueing it, so they
  * hook themselves as listeners on their inputs.
  */
-class INET_API SchedulerBase : public cSimpleModule, public IPassiveQueue, public IPassiveQueueListener
+class INET_API SchedulerBase : public FusedModuleBase, public IPassiveQueue, public IPassiveQueueListener
 {
     protected:
         // state
@@ -0,0 +1,45 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __INET_AIRFRAME_H
+#define __INET_AIRFRAME_H
+
+#include "INETDefs.h"
+#include "ObjectPool.h"
+#include "AirFrame_m.h"
+
+/**
+ * Represents a frame on the radio channel. More info in the AirFrame.msg
+ * file (and the documentation generated from it).
+ *
+ * Customized only to allocate frames from an ObjectPool, as the channel
+ * makes a copy of every frame for each receiver in range.
+ */
+class INET_API AirFrame : public AirFrame_Base
+{
+    INET_POOLED_ALLOCATION(AirFrame)
+
+  public:
+    AirFrame(const char *name = NULL, int kind = 0) : AirFrame_Base(name, kind) {}
+    AirFrame(const AirFrame& other) : AirFrame_Base(other) {}
+    AirFrame& operator=(const AirFrame& other) {AirFrame_Base::operator=(other); return *this;}
+
+    virtual AirFrame *dup() const {return new AirFrame(*this);}
+};
+
+#endif
+
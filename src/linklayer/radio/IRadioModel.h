@@ -19,7 +19,7 @@
 #define IRADIOMODEL_H
 
 #include "INETDefs.h"
-#include "AirFrame_m.h"
+#include "AirFrame.h"
 #include "SnrList.h"
 #include "PhyControlInfo_m.h"
 
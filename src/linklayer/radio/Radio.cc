@@ -47,6 +47,7 @@ Radio::Radio() : rs(this->getId())
     obstacles = NULL;
     radioModel = NULL;
     receptionModel = NULL;
+    useReceivedPowerCache = false;
     transceiverConnected = true;
     receiverConnected = true;
     updateString = NULL;
@@ -127,6 +128,13 @@ void Radio::initialize(int stage)
         receptionModel = (IReceptionModel *) createOne(propModel.c_str());
         receptionModel->initializeFrom(this);
 
+        // received powers can only be reused if the model has no random fading
+        useReceivedPowerCache = par("cacheReceivedPower").boolValue() && receptionModel->isDeterministic();
+        receivedPowerCachePos = getRadioPosition();
+        numReceivedPowerCacheHits = numReceivedPowerCacheMisses = 0;
+        WATCH(numReceivedPowerCacheHits);
+        WATCH(numReceivedPowerCacheMisses);
+
         // adjust the sensitivity in function of maxDistance and reception model
         if (par("maxDistance").doubleValue() > 0)
         {
@@ -203,6 +211,11 @@ void Radio::initialize(int stage)
             nb->fireChangeNotification(NF_RADIO_CHANNEL_CHANGED, &rs);
         }
 
+        // ChannelControl may cull our frames with the same model the receivers use;
+        // stochastic models are left out, since calling them would draw random numbers
+        if (receptionModel->isDeterministic())
+            cc->setRadioReceptionModel(myRadioRef, receptionModel);
+
         // draw the interference distance
         this->updateDisplayString();
     }
@@ -602,25 +615,51 @@ void Radio::handleSelfMsg(cMessage *msg)
  * currently being received message (if any) has to be updated as
  * well as the RadioState.
  */
-void Radio::handleLowerMsgStart(AirFrame* airframe)
+double Radio::calculateReceivedPower(AirFrame *airframe)
 {
-    // Calculate the receive power of the message
-
-    // calculate distance
     const Coord& framePos = airframe->getSenderPos();
-    double distance = getRadioPosition().distance(framePos);
-
-    // calculate receive power
     double frequency = carrierFrequency;
     if (airframe && airframe->getCarrierFrequency()>0.0)
         frequency = airframe->getCarrierFrequency();
 
+    ReceivedPowerCache::iterator it = receivedPowerCache.end();
+    if (useReceivedPowerCache)
+    {
+        std::pair<int, double> key(airframe->getSenderModuleId(), frequency);
+        it = receivedPowerCache.find(key);
+        if (it != receivedPowerCache.end() && it->second.senderPos == framePos && it->second.pSend == airframe->getPSend())
+        {
+            numReceivedPowerCacheHits++;
+            return it->second.rcvdPower;
+        }
+        if (it == receivedPowerCache.end())
+            it = receivedPowerCache.insert(std::make_pair(key, ReceivedPowerCacheEntry())).first;
+        numReceivedPowerCacheMisses++;
+    }
+
+    // calculate distance
+    double distance = getRadioPosition().distance(framePos);
     if (distance<MIN_DISTANCE)
         distance = MIN_DISTANCE;
 
+    // calculate receive power
     double rcvdPower = receptionModel->calculateReceivedPower(airframe->getPSend(), frequency, distance);
     if (obstacles && distance > MIN_DISTANCE)
         rcvdPower = obstacles->calculateReceivedPower(rcvdPower, carrierFrequency, framePos, 0, getRadioPosition(), 0);
+
+    if (it != receivedPowerCache.end())
+    {
+        it->second.senderPos = framePos;
+        it->second.pSend = airframe->getPSend();
+        it->second.rcvdPower = rcvdPower;
+    }
+    return rcvdPower;
+}
+
+void Radio::handleLowerMsgStart(AirFrame* airframe)
+{
+    // Calculate the receive power of the message
+    double rcvdPower = calculateReceivedPower(airframe);
     airframe->setPowRec(rcvdPower);
     // store the receive power in the recvBuff
     recvBuff[airframe] = rcvdPower;
@@ -1047,6 +1086,12 @@ double Radio::calcDistDoubleRay()
 void Radio::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj)
 {
     ChannelAccess::receiveSignal(source,signalID, obj);
+    if (signalID == mobilityStateChangedSignal && getRadioPosition() != receivedPowerCachePos)
+    {
+        // all cached received powers were computed for the old position
+        receivedPowerCache.clear();
+        receivedPowerCachePos = getRadioPosition();
+    }
     if (signalID == changeLevelNoise)
     {
         if (BASE_NOISE_LEVEL < receptionThreshold)
@@ -21,7 +21,7 @@
 
 #include "ChannelAccess.h"
 #include "RadioState.h"
-#include "AirFrame_m.h"
+#include "AirFrame.h"
 #include "IRadioModel.h"
 #include "IReceptionModel.h"
 #include "SnrList.h"
@@ -81,6 +81,9 @@ class INET_API Radio : public ChannelAccess, public ILifecycle
     /** @brief Buffer the frame and update noise levels and snr information */
     virtual void handleLowerMsgStart(AirFrame *airframe);
 
+    /** @brief Calculates the receive power of the frame, or takes it from the received power cache */
+    virtual double calculateReceivedPower(AirFrame *airframe);
+
     /** @brief Unbuffer the frame and update noise levels and snr information */
     virtual void handleLowerMsgEnd(AirFrame *airframe);
 
@@ -160,6 +163,29 @@ class INET_API Radio : public ChannelAccess, public ILifecycle
     IRadioModel *radioModel;
     IReceptionModel *receptionModel;
 
+    /**
+     * Received power of the last frame from a given sender radio on a given
+     * carrier frequency. It is only reused for frames with the same sender
+     * position and transmit power, so it is exact for deterministic reception
+     * models (see IReceptionModel::isDeterministic()).
+     */
+    struct ReceivedPowerCacheEntry
+    {
+        Coord senderPos;
+        double pSend;
+        double rcvdPower;
+    };
+    typedef std::map<std::pair<int, double>, ReceivedPowerCacheEntry> ReceivedPowerCache;
+
+    /** @name Received power cache, cleared whenever this radio moves */
+    //@{
+    bool useReceivedPowerCache;
+    ReceivedPowerCache receivedPowerCache;
+    Coord receivedPowerCachePos;
+    long numReceivedPowerCacheHits;
+    long numReceivedPowerCacheMisses;
+    //@}
+
     /** @name Statistics */
     //@{
     long numGivenUp;
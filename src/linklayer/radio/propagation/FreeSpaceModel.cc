@@ -59,6 +59,14 @@ double FreeSpaceModel::calculateReceivedPower(double pSend, double carrierFreque
     return prec;
 }
 
+void FreeSpaceModel::calculateReceivedPowers(double pSend, double carrierFrequency, const double *distances, double *powers, int count)
+{
+    double waveLength = SPEED_OF_LIGHT / carrierFrequency;
+    freeSpace(Gt, Gr, L, pSend, waveLength, distances, powers, count, pathLossAlpha);
+    for (int i = 0; i < count; i++)
+        powers[i] = powers[i] > pSend ? pSend : powers[i];
+}
+
 /** @brief calculates the power with the deterministic free space propagation model */
 double FreeSpaceModel::freeSpace(double Gt, double Gr, double L, double Pt, double lambda, double distance, double alpha)
 {
@@ -81,6 +89,32 @@ double FreeSpaceModel::freeSpace(double Gt, double Gr, double L, double Pt, doub
   return pr;
 }
 
+void FreeSpaceModel::freeSpace(double Gt, double Gr, double L, double Pt, double lambda, const double *distances, double *powers, int count, double alpha)
+{
+    // the same expression as above, evaluated in the same order, so the results are identical;
+    // pow(d, 2) is exact, like d * d, but only the latter lets the loop be vectorized
+    double numerator = Pt * lambda * lambda * Gt * Gr;
+    double denominatorFactor = 16.0 * M_PI * M_PI;
+    if (alpha == 2.0)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            double d = distances[i];
+            double pr = numerator / (denominatorFactor * (d * d) * L);
+            powers[i] = d == 0.0 ? Pt : pr;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+        {
+            double d = distances[i];
+            double pr = numerator / (denominatorFactor * pow(d, alpha) * L);
+            powers[i] = d == 0.0 ? Pt : pr;
+        }
+    }
+}
+
 double FreeSpaceModel::calculateDistance(double pSend, double pRec, double carrierFrequency)
 {
   /** @brief
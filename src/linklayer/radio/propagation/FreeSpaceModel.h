@@ -57,7 +57,9 @@ public:
      * To be redefined to calculate the received power of a transmission.
      */
     virtual double calculateReceivedPower(double pSend, double carrierFrequency, double distance);
+    virtual void calculateReceivedPowers(double pSend, double carrierFrequency, const double *distances, double *powers, int count);
     virtual double calculateDistance(double pSend, double pRec, double carrierFrequency);
+    virtual bool isDeterministic() const { return true; }
     ~FreeSpaceModel() { };
 
     protected:
@@ -65,6 +67,8 @@ public:
         double pathLossAlpha;
         virtual void initializeFreeSpace(cModule *);
         virtual double freeSpace(double Gt, double Gr, double L, double Pt, double lambda, double distance, double pathLossAlpha);
+        /** @brief freeSpace() for count distances at once */
+        virtual void freeSpace(double Gt, double Gr, double L, double Pt, double lambda, const double *distances, double *powers, int count, double pathLossAlpha);
 };
 
 
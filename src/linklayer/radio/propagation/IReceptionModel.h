@@ -40,6 +40,27 @@ class INET_API IReceptionModel : public cObject
      */
     virtual double calculateReceivedPower(double pSend, double carrierFrequency, double distance) = 0;
 
+    /**
+     * Calculates the received powers of one transmission at count receivers,
+     * given their distances from the transmitter. The default implementation
+     * calls calculateReceivedPower() for each; deterministic models redefine
+     * it with the per-transmission terms hoisted out of a branch-free loop
+     * that the compiler can vectorize. The results must be the same as those
+     * of calculateReceivedPower().
+     */
+    virtual void calculateReceivedPowers(double pSend, double carrierFrequency, const double *distances, double *powers, int count)
+    {
+        for (int i = 0; i < count; i++)
+            powers[i] = calculateReceivedPower(pSend, carrierFrequency, distances[i]);
+    }
+
+    /**
+     * Returns true if calculateReceivedPower() always returns the same value
+     * for the same arguments, i.e. the model contains no random fading or
+     * shadowing. The radio may then cache received powers.
+     */
+    virtual bool isDeterministic() const { return false; }
+
     /**
      * Virtual destructor.
      */
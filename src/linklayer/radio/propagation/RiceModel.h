@@ -51,6 +51,12 @@ class INET_API RiceModel : public FreeSpaceModel {
      * To be redefined to calculate the received power of a transmission.
      */
     virtual double calculateReceivedPower(double pSend, double carrierFrequency, double distance);
+    /** @brief per-receiver calculateReceivedPower(), not the free space batch kernel */
+    virtual void calculateReceivedPowers(double pSend, double carrierFrequency, const double *distances, double *powers, int count)
+    {
+        IReceptionModel::calculateReceivedPowers(pSend, carrierFrequency, distances, powers, count);
+    }
+    virtual bool isDeterministic() const { return false; }
     private:
     /** @brief  Ricean K Factor */
     double K;
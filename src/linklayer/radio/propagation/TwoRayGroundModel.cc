@@ -84,3 +84,19 @@ double TwoRayGroundModel::calculateReceivedPower(double pSend, double carrierFre
         return prec;
     }
 }
+
+void TwoRayGroundModel::calculateReceivedPowers(double pSend, double carrierFrequency, const double *distances, double *powers, int count)
+{
+    // free space below the cross over distance, two-ray ground above it, as in calculateReceivedPower()
+    double waveLength = SPEED_OF_LIGHT / carrierFrequency;
+    double dc = (4 * M_PI * ht * hr ) / waveLength;
+    freeSpace(Gt, Gr, L, pSend, waveLength, distances, powers, count, pathLossAlpha);
+    double numerator = pSend * Gt * Gr * (ht * ht * hr * hr);
+    for (int i = 0; i < count; i++)
+    {
+        double d = distances[i];
+        double prec = numerator / (d * d * d * d * L);
+        prec = prec > pSend ? pSend : prec;
+        powers[i] = (d == 0 || d < dc) ? powers[i] : prec;
+    }
+}
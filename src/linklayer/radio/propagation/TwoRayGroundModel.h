@@ -34,8 +34,9 @@ class INET_API TwoRayGroundModel : public FreeSpaceModel {
      * To be redefined to calculate the received power of a transmission.
      */
     virtual double calculateReceivedPower(double pSend, double carrierFrequency, double distance);
+    virtual void calculateReceivedPowers(double pSend, double carrierFrequency, const double *distances, double *powers, int count);
 
-    private:
+    protected:
     double ht, hr;
 };
 
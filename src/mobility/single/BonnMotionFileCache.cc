@@ -19,14 +19,87 @@
 #include <fstream>
 #include <sstream>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "BonnMotionFileCache.h"
 
+// layout of the header of binary trace files (see etc/motiontrace2bin.py)
+#define BINARY_TRACE_MAGIC          "INETMTRC"
+#define BINARY_TRACE_VERSION        1
+#define BINARY_TRACE_BYTEORDER      0x01020304
+#define BINARY_TRACE_HEADER_LENGTH  32
+
+// number of values stored per setdest command in ns-2 traces: t x y speed
+#define NS2_RECORD_LENGTH  4
+
+
+BonnMotionFile::BonnMotionFile()
+{
+    format = BONNMOTION;
+    mapping = NULL;
+    mappingSize = 0;
+    offsets = NULL;
+    column = NULL;
+    numLines = 0;
+}
+
+BonnMotionFile::~BonnMotionFile()
+{
+    releaseMapping();
+}
+
+void BonnMotionFile::releaseMapping()
+{
+#ifndef _WIN32
+    if (mapping && heapCopy.empty())
+        munmap((void *)mapping, mappingSize);
+#endif
+    heapCopy.clear();
+    mapping = NULL;
+    mappingSize = 0;
+    offsets = NULL;
+    column = NULL;
+}
 
 const BonnMotionFile::Line *BonnMotionFile::getLine(int nodeId) const
 {
-    LineList::const_iterator it = lines.begin();
-    for (int i=0; i<nodeId && it!=lines.end(); i++) it++;
-    return (it==lines.end()) ? NULL : &(*it);
+    if (nodeId < 0 || (unsigned int)nodeId >= numLines)
+        return NULL;
+    if (!isDecoded[nodeId])
+    {
+        if (column)
+            lineViews[nodeId] = Line(column + offsets[nodeId], (unsigned int)(offsets[nodeId + 1] - offsets[nodeId]));
+        else
+            decodeTextLine(nodeId);
+        isDecoded[nodeId] = true;
+    }
+    return &lineViews[nodeId];
+}
+
+void BonnMotionFile::decodeTextLine(unsigned int index) const
+{
+    std::vector<double>& vec = decodedLines[index];
+    if (!lineStarts.empty())
+    {
+        // copy the line so that strtod() cannot run past the end of the mapping
+        std::string line(mapping + lineStarts[index], mapping + lineStarts[index + 1]);
+        const char *s = line.c_str();
+        while (true)
+        {
+            char *end;
+            double d = strtod(s, &end);
+            if (end == s)
+                break;
+            vec.push_back(d);
+            s = end;
+        }
+    }
+    lineViews[index] = vec.empty() ? Line() : Line(&vec[0], vec.size());
 }
 
 
@@ -48,35 +121,201 @@ void BonnMotionFileCache::deleteInstance()
     }
 }
 
-const BonnMotionFile *BonnMotionFileCache::getFile(const char *filename)
+BonnMotionFileCache::~BonnMotionFileCache()
+{
+    for (BMFileMap::iterator it = cache.begin(); it != cache.end(); ++it)
+        delete it->second;
+}
+
+const BonnMotionFile *BonnMotionFileCache::getFile(const char *filename, BonnMotionFile::Format format)
 {
     // if found, return it from cache
-    BMFileMap::iterator it = cache.find(std::string(filename));
+    std::string key = std::string(format == BonnMotionFile::NS2 ? "ns2:" : "bm:") + filename;
+    BMFileMap::iterator it = cache.find(key);
     if (it!=cache.end())
-        return &(it->second);
+        return it->second;
 
     // load and store in cache
-    BonnMotionFile& bmFile = cache[filename];
-    parseFile(filename, bmFile);
-    return &bmFile;
+    BonnMotionFile *bmFile = new BonnMotionFile();
+    bmFile->format = format;
+    bmFile->filename = filename;
+    try
+    {
+        mapFile(filename, *bmFile);
+        if (!parseBinaryFile(*bmFile))
+        {
+            if (format == BonnMotionFile::NS2)
+                parseNs2File(*bmFile);
+            else
+                parseFile(*bmFile);
+        }
+    }
+    catch (...)
+    {
+        delete bmFile;
+        throw;
+    }
+    bmFile->lineViews.resize(bmFile->numLines);
+    bmFile->isDecoded.resize(bmFile->numLines, false);
+    cache[key] = bmFile;
+    return bmFile;
 }
 
-void BonnMotionFileCache::parseFile(const char *filename, BonnMotionFile& bmFile)
+void BonnMotionFileCache::mapFile(const char *filename, BonnMotionFile& bmFile)
 {
-    std::ifstream in(filename, std::ios::in);
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        throw cRuntimeError("Cannot open file '%s'", filename);
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        throw cRuntimeError("Cannot stat file '%s'", filename);
+    }
+    bmFile.mappingSize = st.st_size;
+    if (bmFile.mappingSize > 0)
+    {
+        void *addr = mmap(NULL, bmFile.mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            close(fd);
+            throw cRuntimeError("Cannot map file '%s' into memory", filename);
+        }
+        bmFile.mapping = (const char *)addr;
+    }
+    close(fd);
+#else
+    // no mmap(): read the file into an 8-byte aligned buffer instead
+    std::ifstream in(filename, std::ios::in | std::ios::binary);
     if (in.fail())
         throw cRuntimeError("Cannot open file '%s'", filename);
+    in.seekg(0, std::ios::end);
+    bmFile.mappingSize = (size_t)in.tellg();
+    in.seekg(0, std::ios::beg);
+    if (bmFile.mappingSize > 0)
+    {
+        bmFile.heapCopy.resize((bmFile.mappingSize + sizeof(double) - 1) / sizeof(double));
+        in.read((char *)&bmFile.heapCopy[0], bmFile.mappingSize);
+        bmFile.mapping = (const char *)&bmFile.heapCopy[0];
+    }
+    in.close();
+#endif
+}
+
+bool BonnMotionFileCache::parseBinaryFile(BonnMotionFile& bmFile)
+{
+    const char *filename = bmFile.filename.c_str();
+    if (bmFile.mappingSize < BINARY_TRACE_HEADER_LENGTH || memcmp(bmFile.mapping, BINARY_TRACE_MAGIC, 8) != 0)
+        return false;
 
+    const uint32 *header = (const uint32 *)(bmFile.mapping + 8);
+    if (header[0] != BINARY_TRACE_VERSION)
+        throw cRuntimeError("Unsupported binary trace file version %u in '%s'", header[0], filename);
+    if (header[1] != (uint32)bmFile.format)
+        throw cRuntimeError("Binary trace file '%s' was converted from a %s trace", filename, header[1] == BonnMotionFile::NS2 ? "ns-2" : "BonnMotion");
+    if (header[2] != BINARY_TRACE_BYTEORDER)
+        throw cRuntimeError("Binary trace file '%s' was written with a different byte order", filename);
+
+    uint64 numLines = *(const uint64 *)(bmFile.mapping + 24);
+    size_t offsetsLength = (numLines + 1) * sizeof(uint64);
+    if (bmFile.mappingSize < BINARY_TRACE_HEADER_LENGTH + offsetsLength)
+        throw cRuntimeError("Binary trace file '%s' is truncated", filename);
+    bmFile.offsets = (const uint64 *)(bmFile.mapping + BINARY_TRACE_HEADER_LENGTH);
+    bmFile.column = (const double *)(bmFile.mapping + BINARY_TRACE_HEADER_LENGTH + offsetsLength);
+    size_t columnLength = (bmFile.mappingSize - BINARY_TRACE_HEADER_LENGTH - offsetsLength) / sizeof(double);
+    if (bmFile.offsets[numLines] > columnLength)
+        throw cRuntimeError("Binary trace file '%s' is truncated", filename);
+    bmFile.numLines = (unsigned int)numLines;
+    return true;
+}
+
+void BonnMotionFileCache::parseFile(BonnMotionFile& bmFile)
+{
+    // only index the lines here, numbers are parsed on demand in getLine()
+    const char *start = bmFile.mapping;
+    const char *end = start + bmFile.mappingSize;
+    const char *p = start;
+    while (p < end)
+    {
+        bmFile.lineStarts.push_back(p - start);
+        const char *eol = (const char *)memchr(p, '\n', end - p);
+        p = eol ? eol + 1 : end;
+    }
+    bmFile.lineStarts.push_back(end - start);
+    bmFile.numLines = bmFile.lineStarts.size() - 1;
+    bmFile.decodedLines.resize(bmFile.numLines);
+}
+
+void BonnMotionFileCache::parseNs2File(BonnMotionFile& bmFile)
+{
+    // ns-2 commands of the nodes are interleaved, so the whole file is parsed
+    // here; line i receives "x0 y0 z0 t1 x1 y1 speed1 t2 ..." for $node_(i)
+    std::istringstream in(std::string(bmFile.mapping, bmFile.mapping + bmFile.mappingSize));
+    std::vector<std::vector<double> >& nodes = bmFile.decodedLines;
     std::string line;
     while (std::getline(in, line))
     {
-        bmFile.lines.push_back(BonnMotionFile::Line());
-        BonnMotionFile::Line& vec = bmFile.lines.back();
+        // '#' line
+        std::string::size_type found = line.find('#');
+        if (found == 0)
+            continue;
+        found = line.find("$node_");
+        if (found == std::string::npos)
+            continue;
+        // Node Id
+        std::string::size_type pos1 = line.find('(');
+        std::string::size_type pos2 = line.find(')');
+        if (pos1 == std::string::npos || pos2 == std::string::npos || pos2-pos1 <= 1)
+            continue;
+        int nodeId = std::atoi(line.substr(pos1+1, pos2-pos1-1).c_str());
+        if (nodeId < 0)
+            continue;
+        if ((int)nodes.size() <= nodeId)
+            nodes.resize(nodeId + 1);
+        std::vector<double>& vec = nodes[nodeId];
+        if (vec.empty())
+            vec.resize(3, -1);
+        found = line.find("setdest");
+        if (found != std::string::npos)
+        {
+            // initial time
+            found = line.find("at");
+            vec.push_back(std::atof(line.substr(found+3).c_str()));
 
-        std::stringstream linestream(line);
-        double d;
-        while (linestream >> d)
-            vec.push_back(d);
+            std::string parameters = line.substr(line.find("setdest ")+8, std::string::npos);
+            std::stringstream linestream(parameters);
+            double d;
+            int count = 0;
+            while (count < NS2_RECORD_LENGTH-1 && linestream >> d)
+            {
+                vec.push_back(d);
+                count++;
+            }
+            for ( ; count < NS2_RECORD_LENGTH-1; count++)
+                vec.push_back(0);
+        }
+        else if (line.find("set ") != std::string::npos)
+        {
+            // Initial position
+            found = line.find("X_");
+            if (found != std::string::npos)
+                vec[0] = std::atof(line.substr(found+3, std::string::npos).c_str());
+            found = line.find("Y_");
+            if (found != std::string::npos)
+                vec[1] = std::atof(line.substr(found+3, std::string::npos).c_str());
+            found = line.find("Z_");
+            if (found != std::string::npos)
+                vec[2] = std::atof(line.substr(found+3, std::string::npos).c_str());
+        }
     }
-    in.close();
+    bmFile.numLines = nodes.size();
+    bmFile.lineViews.resize(bmFile.numLines);
+    for (unsigned int i = 0; i < bmFile.numLines; i++)
+        if (!nodes[i].empty())
+            bmFile.lineViews[i] = BonnMotionFile::Line(&nodes[i][0], nodes[i].size());
+    bmFile.isDecoded.resize(bmFile.numLines, true);
+
+    // the text is no longer needed
+    bmFile.releaseMapping();
 }
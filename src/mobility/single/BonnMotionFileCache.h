@@ -19,7 +19,6 @@
 #ifndef BONN_MOTION_FILE_CACHE_H
 #define BONN_MOTION_FILE_CACHE_H
 
-#include <list>
 #include <vector>
 
 #include "INETDefs.h"
@@ -28,26 +27,94 @@
 class BonnMotionFileCache;
 
 /**
- * Represents a BonnMotion file's contents.
- * @see BonnMotionFileCache, BonnMotionMobility
+ * Represents a motion trace file's contents: one line of numbers per node.
+ *
+ * Text files are mapped into memory and only indexed at load time; the
+ * numbers of a line are parsed when the line is first requested.
+ * Binary (columnar) trace files, as produced by etc/motiontrace2bin.py,
+ * are mapped read-only and the lines point directly into the mapping,
+ * so nothing needs to be decoded at all.
+ *
+ * @see BonnMotionFileCache, BonnMotionMobility, Ns2MotionMobility
  */
 class INET_API BonnMotionFile
 {
   public:
-    typedef std::vector<double> Line;
+    /**
+     * Read-only view of the numbers of one line of the file.
+     */
+    class Line
+    {
+      protected:
+        const double *data;
+        unsigned int length;
+      public:
+        Line() : data(NULL), length(0) {}
+        Line(const double *data, unsigned int length) : data(data), length(length) {}
+        unsigned int size() const { return length; }
+        bool empty() const { return length == 0; }
+        double operator[](unsigned int i) const { return data[i]; }
+    };
+
+    /** Trace formats; also stored in the header of binary trace files. */
+    enum Format { BONNMOTION = 0, NS2 = 1 };
+
   protected:
     friend class BonnMotionFileCache;
-    typedef std::list<Line> LineList;
-    LineList lines;
+
+    Format format;
+    std::string filename;
+
+    // the whole file, mapped read-only (or copied into heapCopy where mmap is not available)
+    const char *mapping;
+    size_t mappingSize;
+    std::vector<double> heapCopy;
+
+    // binary files: per-line offsets into the double column, numLines+1 entries
+    const uint64 *offsets;
+    const double *column;
+
+    // text files: start offset of each line in the mapping, numLines+1 entries
+    std::vector<size_t> lineStarts;
+    mutable std::vector<std::vector<double> > decodedLines;
+
+    // lazily filled views, one per line
+    unsigned int numLines;
+    mutable std::vector<Line> lineViews;
+    mutable std::vector<bool> isDecoded;
+
+  protected:
+    void decodeTextLine(unsigned int index) const;
+    void releaseMapping();
+
   public:
+    BonnMotionFile();
+    ~BonnMotionFile();
+
+    /** Returns true if the file was loaded from the binary columnar format */
+    bool isBinary() const { return column != NULL; }
+
+    /** Returns the number of lines (nodes) in the file */
+    unsigned int getNumLines() const { return numLines; }
+
+    /**
+     * Returns the given line, or NULL if the file has no such line.
+     * For ns-2 files, line i contains the motion of $node_(i) as
+     * x0 y0 z0 followed by (t x y speed) quadruples.
+     */
     const Line *getLine(int nodeId) const;
+
+  private:
+    // not copyable: owns the mapping
+    BonnMotionFile(const BonnMotionFile&);
+    BonnMotionFile& operator=(const BonnMotionFile&);
 };
 
 
 /**
- * Singleton object to read and store BonnMotion files. Used within
- * BonnMotionMobility.  Needed because otherwise every node would
- * have to open and read the file independently.
+ * Singleton object to read and store BonnMotion and ns-2 motion files. Used
+ * within BonnMotionMobility and Ns2MotionMobility. Needed because otherwise
+ * every node would have to open and read the file independently.
  *
  * @ingroup mobility
  * @author Andras Varga
@@ -55,12 +122,17 @@ class INET_API BonnMotionFile
 class INET_API BonnMotionFileCache
 {
   protected:
-    typedef std::map<std::string,BonnMotionFile> BMFileMap;
+    typedef std::map<std::string,BonnMotionFile *> BMFileMap;
     BMFileMap cache;
     static BonnMotionFileCache *inst;
-    void parseFile(const char *filename, BonnMotionFile& bmFile);
+
+    const BonnMotionFile *getFile(const char *filename, BonnMotionFile::Format format);
+    void mapFile(const char *filename, BonnMotionFile& bmFile);
+    bool parseBinaryFile(BonnMotionFile& bmFile);
+    void parseFile(BonnMotionFile& bmFile);
+    void parseNs2File(BonnMotionFile& bmFile);
     BonnMotionFileCache() {}
-    virtual ~BonnMotionFileCache() {}
+    virtual ~BonnMotionFileCache();
 
   public:
     /**
@@ -74,9 +146,15 @@ class INET_API BonnMotionFileCache
     static void deleteInstance();
 
     /**
-     * Returns the given document.
+     * Returns the given BonnMotion trace (text or binary).
+     */
+    virtual const BonnMotionFile *getFile(const char *filename) { return getFile(filename, BonnMotionFile::BONNMOTION); }
+
+    /**
+     * Returns the given ns-2 motion trace (text or binary). The text file is
+     * parsed only once, regardless of the number of nodes referring to it.
      */
-    virtual const BonnMotionFile *getFile(const char *filename);
+    virtual const BonnMotionFile *getNs2File(const char *filename) { return getFile(filename, BonnMotionFile::NS2); }
 };
 
 #endif
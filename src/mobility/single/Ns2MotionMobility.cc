@@ -18,16 +18,13 @@
 //
 
 
-#include <fstream>
-#include <sstream>
-#include <string>
-
 #include "Ns2MotionMobility.h"
 #include "FWMath.h"
 
-#ifndef atoi
-#include <cstdlib>
-#endif
+// the initial position (x0 y0 z0) precedes the setdest records in a trace line
+#define NS2_INITIAL_LENGTH  3
+// values per setdest record: t x y speed
+#define NS2_RECORD_LENGTH   4
 
 
 Define_Module(Ns2MotionMobility);
@@ -36,7 +33,7 @@ Define_Module(Ns2MotionMobility);
 Ns2MotionMobility::Ns2MotionMobility()
 {
     vecpos = 0;
-    ns2File = NULL;
+    lines = NULL;
     nodeId = 0;
     scrollX = 0;
     scrollY = 0;
@@ -44,86 +41,17 @@ Ns2MotionMobility::Ns2MotionMobility()
 
 Ns2MotionMobility::~Ns2MotionMobility()
 {
-    if (ns2File)
-        delete ns2File;
+    BonnMotionFileCache::deleteInstance();
 }
 
-void Ns2MotionMobility::parseFile(const char *filename)
+unsigned int Ns2MotionMobility::getNumRecords() const
 {
+    return (lines->size() - NS2_INITIAL_LENGTH) / NS2_RECORD_LENGTH;
+}
 
-    std::ifstream in(filename, std::ios::in);
-
-    if (in.fail())
-        throw cRuntimeError("Cannot open file '%s'", filename);
-    ns2File->initial[0] = ns2File->initial[1] = ns2File->initial[2] = -1;
-    std::string line;
-    std::string subline;
-
-    while (std::getline(in, line))
-    {
-        // '#' line
-        int num_node;
-        std::string::size_type found = line.find('#');
-        if (found == 0)
-            continue;
-        if (found != std::string::npos)
-            subline = line;
-        else
-            subline = line.substr(0, found);
-        found = subline.find("$node_");
-        if (found == std::string::npos)
-            continue;
-        // Node Id
-        std::string::size_type pos1 = subline.find('(');
-        std::string::size_type pos2 = subline.find(')');
-        if (pos2-pos1>1)
-            num_node = std::atoi(subline.substr(pos1+1, pos2-1).c_str());
-        if (num_node!=nodeId)
-            continue;
-        // Initial position
-        found = subline.find("set ");
-        if (found!=std::string::npos)
-        {
-            // Initial position
-            found = subline.find("X_");
-            if (found!=std::string::npos)
-            {
-                ns2File->initial[0] = std::atof(subline.substr(found+3, std::string::npos).c_str());
-            }
-            found = subline.find("Y_");
-            if (found!=std::string::npos)
-            {
-                ns2File->initial[1] = std::atof(subline.substr(found+3, std::string::npos).c_str());
-            }
-
-            found = subline.find("Z_");
-            if (found!=std::string::npos)
-            {
-                ns2File->initial[2] = std::atof(subline.substr(found+3, std::string::npos).c_str());
-            }
-        }
-        found = subline.find("setdest");
-        if (found!=std::string::npos)
-        {
-            ns2File->lines.push_back(Ns2MotionFile::Line());
-            Ns2MotionFile::Line& vec = ns2File->lines.back();
-            // initial time
-            found = subline.find("at");
-            vec.push_back(std::atof(subline.substr(found+3).c_str()));
-
-            std::string parameters = subline.substr(subline.find("setdest ")+8, std::string::npos);
-
-            std::stringstream linestream(parameters);
-            double d;
-            while (linestream >> d)
-                vec.push_back(d);
-        }
-    }
-    in.close();
-    // exist data?
-    if (ns2File->initial[0]==-1 || ns2File->initial[1]==-1 || ns2File->initial[2]==-1)
-        throw cRuntimeError("node '%d' Error ns2 motion file '%s'", nodeId, filename);
-
+double Ns2MotionMobility::getRecordValue(unsigned int record, int field) const
+{
+    return (*lines)[NS2_INITIAL_LENGTH + record * NS2_RECORD_LENGTH + field];
 }
 
 void Ns2MotionMobility::initialize(int stage)
@@ -139,8 +67,11 @@ void Ns2MotionMobility::initialize(int stage)
         if (nodeId == -1)
             nodeId = getContainingNode(this)->getIndex();
         const char *fname = par("traceFile");
-        ns2File = new Ns2MotionFile;
-        parseFile(fname);
+        const BonnMotionFile *ns2File = BonnMotionFileCache::getInstance()->getNs2File(fname);
+        lines = ns2File->getLine(nodeId);
+        // exist data?
+        if (!lines || lines->size() < NS2_INITIAL_LENGTH || (*lines)[0]==-1 || (*lines)[1]==-1 || (*lines)[2]==-1)
+            throw cRuntimeError("node '%d' Error ns2 motion file '%s'", nodeId, fname);
         vecpos = 0;
         WATCH(nodeId);
     }
@@ -148,34 +79,19 @@ void Ns2MotionMobility::initialize(int stage)
 
 void Ns2MotionMobility::setInitialPosition()
 {
-    lastPosition.x = ns2File->initial[0]+scrollX;
-    lastPosition.y = ns2File->initial[1]+scrollY;
+    lastPosition.x = (*lines)[0]+scrollX;
+    lastPosition.y = (*lines)[1]+scrollY;
 }
 
 void Ns2MotionMobility::setTargetPosition()
 {
-
-    if (ns2File->lines.size()==0)
+    if (vecpos >= getNumRecords())
     {
         stationary = true;
         return;
     }
 
-    if (vecpos >= ns2File->lines.size())
-    {
-        stationary = true;
-        return;
-    }
-
-
-    if (ns2File->lines.begin()+vecpos == ns2File->lines.end())
-    {
-        stationary = true;
-        return;
-    }
-
-    const Ns2MotionFile::Line& vec = ns2File->lines[vecpos];
-    double time = vec[0];
+    double time = getRecordValue(vecpos, 0);
     simtime_t now = simTime();
     // TODO: this code is dubious at best
     if (now < time)
@@ -183,19 +99,23 @@ void Ns2MotionMobility::setTargetPosition()
         nextChange = time;
         targetPosition = lastPosition;
     }
-    else if (vec[3] == 0) // the node is stopped
+    else if (getRecordValue(vecpos, 3) == 0) // the node is stopped
     {
-        const Ns2MotionFile::Line& vec = ns2File->lines[vecpos+1];
-        double time = vec[0];
+        if (vecpos + 1 >= getNumRecords())
+        {
+            stationary = true;
+            return;
+        }
+        double time = getRecordValue(vecpos+1, 0);
         nextChange = time;
         targetPosition = lastPosition;
         vecpos++;
     }
     else
     {
-        targetPosition.x = vec[1]+scrollX;
-        targetPosition.y = vec[2]+scrollY;
-        double speed = vec[3];
+        targetPosition.x = getRecordValue(vecpos, 1)+scrollX;
+        targetPosition.y = getRecordValue(vecpos, 2)+scrollY;
+        double speed = getRecordValue(vecpos, 3);
         double distance = lastPosition.distance(targetPosition);
         double travelTime = distance / speed;
         nextChange = now + travelTime;
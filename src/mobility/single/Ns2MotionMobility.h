@@ -24,43 +24,31 @@
 #include "INETDefs.h"
 
 #include "LineSegmentsMobilityBase.h"
+#include "BonnMotionFileCache.h"
 
 
 /**
  * @brief Uses the ns2 motion native file format. See NED file for more info.
  *
+ * The trace file is parsed only once and shared by all nodes through
+ * BonnMotionFileCache.
+ *
  * @ingroup mobility
  * @author Alfonso Ariza
  */
-
-class Ns2MotionMobility;
-
-/**
- * Represents a ns2 motion file's contents.
- */
-class INET_API Ns2MotionFile
-{
-  public:
-    typedef std::vector<double> Line;
-    double initial[3];
-  protected:
-    friend class Ns2MotionMobility;
-    typedef std::vector<Line> LineList;
-    LineList lines;
-};
-
 class INET_API Ns2MotionMobility : public LineSegmentsMobilityBase
 {
   protected:
     // state
     unsigned int vecpos;
-    Ns2MotionFile *ns2File;
+    const BonnMotionFile::Line *lines;  // x0 y0 z0, then (t x y speed) per setdest command
     int nodeId;
     double scrollX;
     double scrollY;
 
   protected:
-    void parseFile(const char *filename);
+    unsigned int getNumRecords() const;
+    double getRecordValue(unsigned int record, int field) const;
 
     virtual int numInitStages() const { return 3; }
 
@@ -31,6 +31,7 @@
 #include "RoutingTableAccess.h"
 #include "NodeOperations.h"
 #include "NodeStatus.h"
+#include "TimerWheel.h"
 
 
 simsignal_t ARP::sentReqSignal = registerSignal("sentReq");
@@ -68,6 +69,7 @@ ARP::ARP()
     }
 
     ift = NULL;
+    timerWheel = NULL;
     rt = NULL;
 }
 
@@ -85,6 +87,9 @@ void ARP::initialize(int stage)
 
         netwOutGate = gate("netwOut");
 
+        if (par("useTimerWheel").boolValue())
+            timerWheel = new TimerWheel(this, SIMTIME_ZERO, "arpTimerWheelTick");
+
         // init statistics
         numRequestsSent = numRepliesSent = 0;
         numResolutions = numFailedResolutions = 0;
@@ -148,6 +153,7 @@ ARP::~ARP()
         delete (*i).second;
         arpCache.erase(i);
     }
+    delete timerWheel;
     --globalArpCacheRefCnt;
     // delete my entries from the globalArpCache
     for (ARPCache::iterator it = globalArpCache.begin(); it != globalArpCache.end(); )
@@ -171,7 +177,12 @@ void ARP::handleMessage(cMessage *msg)
         return;
     }
 
-    if (msg->isSelfMessage())
+    if (timerWheel && timerWheel->isTick(msg))
+    {
+        while (cMessage *timer = timerWheel->popExpiredTimer())
+            requestTimedOut(timer);
+    }
+    else if (msg->isSelfMessage())
     {
         requestTimedOut(msg);
     }
@@ -238,12 +249,30 @@ void ARP::flush()
         ARPCache::iterator i = arpCache.begin();
         ARPCacheEntry *entry = i->second;
         if (entry->timer) {
-            delete cancelEvent(entry->timer);
+            cancelAndDeleteTimer(entry->timer);
             entry->timer = NULL;
         }
         delete entry;
         arpCache.erase(i);
     }
+    if (timerWheel)
+        timerWheel->clear();
+}
+
+void ARP::scheduleTimer(simtime_t t, cMessage *timer)
+{
+    if (timerWheel)
+        timerWheel->scheduleAt(t, timer);
+    else
+        scheduleAt(t, timer);
+}
+
+void ARP::cancelAndDeleteTimer(cMessage *timer)
+{
+    if (timerWheel)
+        delete timerWheel->cancel(timer);
+    else
+        delete cancelEvent(timer);
 }
 
 bool ARP::isNodeUp()
@@ -274,7 +303,7 @@ void ARP::initiateARPResolution(ARPCacheEntry *entry)
     // start timer
     cMessage *msg = entry->timer = new cMessage("ARP timeout");
     msg->setContextPointer(entry);
-    scheduleAt(simTime()+retryTimeout, msg);
+    scheduleTimer(simTime()+retryTimeout, msg);
 
     numResolutions++;
     Notification signal(nextHopAddr, MACAddress::UNSPECIFIED_ADDRESS, entry->ie);
@@ -327,7 +356,7 @@ void ARP::requestTimedOut(cMessage *selfmsg)
         IPv4Address nextHopAddr = entry->myIter->first;
         EV << "ARP request for " << nextHopAddr << " timed out, resending\n";
         sendARPRequest(entry->ie, nextHopAddr);
-        scheduleAt(simTime()+retryTimeout, selfmsg);
+        scheduleTimer(simTime()+retryTimeout, selfmsg);
         return;
     }
 
@@ -503,7 +532,7 @@ void ARP::updateARPCache(ARPCacheEntry *entry, const MACAddress& macAddress)
     if (entry->pending)
     {
         entry->pending = false;
-        delete cancelEvent(entry->timer);
+        cancelAndDeleteTimer(entry->timer);
         entry->timer = NULL;
         entry->numRetries = 0;
     }
@@ -537,7 +566,7 @@ MACAddress ARP::getMACAddressFor(const IPv4Address& addr) const
 
 void ARP::startAddressResolution(const IPv4Address& addr, const InterfaceEntry *ie)
 {
-    Enter_Method("startAddressResolution(%s,%s)", addr.str().c_str(), ie->getName());
+    Enter_Method_Lazy("startAddressResolution(%s,%s)", addr.str().c_str(), ie->getName());
 
     if (globalARP)
     {
@@ -35,6 +35,7 @@ class ARPPacket;
 class IInterfaceTable;
 class InterfaceEntry;
 class IRoutingTable;
+class TimerWheel;
 
 /**
  * ARP implementation.
@@ -87,6 +88,8 @@ class INET_API ARP : public cSimpleModule, public IARPCache, public ILifecycle,
 
     cGate *netwOutGate;
 
+    TimerWheel *timerWheel; // request timeouts are kept here instead of the FES if non-NULL
+
     IInterfaceTable *ift;
     IRoutingTable *rt;  // for answering ProxyARP requests
 
@@ -119,6 +122,9 @@ class INET_API ARP : public cSimpleModule, public IARPCache, public ILifecycle,
     virtual void start();
     virtual void flush();
 
+    virtual void scheduleTimer(simtime_t t, cMessage *timer);
+    virtual void cancelAndDeleteTimer(cMessage *timer);
+
     virtual void sendPacketToNIC(cMessage *msg, const InterfaceEntry *ie, const MACAddress& macAddress, int etherType);
 
     virtual void initiateARPResolution(ARPCacheEntry *entry);
@@ -18,7 +18,14 @@
 // Authors: Levente Meszaros (primary author), Andras Varga, Tamas Borbely
 //
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <set>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
 #include "stlutils.h"
 #include "IRoutingTable.h"
 #include "IInterfaceTable.h"
@@ -40,6 +47,64 @@ static void printElapsedTime(const char *name, long startTime)
     EV_INFO << "Time spent in IPv4NetworkConfigurator::" << name << ": " << ((double)(clock() - startTime) / CLOCKS_PER_SEC) << "s" << endl;
 }
 
+// configuration cache file format; bump the version whenever the snapshot contents change
+static const char CONFIG_CACHE_MAGIC[8] = {'I', 'N', 'E', 'T', 'C', 'F', 'G', '1'};
+static const uint32 CONFIG_CACHE_BYTE_ORDER = 0x01020304;
+
+// 64-bit FNV-1a hash
+static void hashBytes(uint64& hash, const void *data, size_t length)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+static void hashString(uint64& hash, const std::string& s)
+{
+    hashBytes(hash, s.c_str(), s.length() + 1);
+}
+
+template<typename T>
+static void hashValue(uint64& hash, const T& value)
+{
+    hashBytes(hash, &value, sizeof(value));
+}
+
+static void hashXML(uint64& hash, cXMLElement *element)
+{
+    if (!element)
+    {
+        hashString(hash, "");
+        return;
+    }
+    hashString(hash, element->getTagName());
+    const cXMLAttributeMap& attributes = element->getAttributes();
+    for (cXMLAttributeMap::const_iterator it = attributes.begin(); it != attributes.end(); ++it)
+    {
+        hashString(hash, it->first);
+        hashString(hash, it->second);
+    }
+    hashString(hash, element->getNodeValue() ? element->getNodeValue() : "");
+    for (cXMLElement *child = element->getFirstChild(); child; child = child->getNextSibling())
+        hashXML(hash, child);
+    hashString(hash, "/");
+}
+
+template<typename T>
+static void writeValue(std::ostream& out, const T& value)
+{
+    out.write((const char *)&value, sizeof(value));
+}
+
+template<typename T>
+static bool readValue(std::istream& in, T& value)
+{
+    return (bool)in.read((char *)&value, sizeof(value));
+}
+
 IPv4NetworkConfigurator::InterfaceInfo::InterfaceInfo(Node *node, LinkInfo *linkInfo, InterfaceEntry *interfaceEntry)
 {
     this->node = node;
@@ -88,6 +153,9 @@ void IPv4NetworkConfigurator::initialize(int stage)
         addDefaultRoutesParameter = par("addDefaultRoutes");
         optimizeRoutesParameter = par("optimizeRoutes");
         configuration = par("config");
+        configCacheDir = par("configCacheDir").stdstringValue();
+        configCacheHit = false;
+        configCacheTimeSaved = 0;
     }
     else if (stage == 2)
         ensureConfigurationComputed(topology);
@@ -95,12 +163,40 @@ void IPv4NetworkConfigurator::initialize(int stage)
         dumpConfiguration();
 }
 
+void IPv4NetworkConfigurator::finish()
+{
+    if (!configCacheDir.empty())
+    {
+        recordScalar("config cache hit", configCacheHit);
+        recordScalar("config cache time saved", configCacheTimeSaved, "s");
+    }
+}
+
 void IPv4NetworkConfigurator::computeConfiguration()
 {
     long initializeStartTime = clock();
     topology.clear();
     // extract topology into the IPv4Topology object, then fill in a LinkInfo[] vector
     T(extractTopology(topology));
+    // reuse the result of a previous run with the same topology and configuration if possible
+    std::string configCacheFile;
+    uint64 configHash = 0;
+    if (!configCacheDir.empty())
+    {
+        configHash = computeConfigurationHash(topology);
+        configCacheFile = getConfigCacheFileName(configHash);
+        long loadStartTime = clock();
+        double computeTime;
+        if (loadConfigCache(topology, configCacheFile.c_str(), configHash, computeTime))
+        {
+            configCacheHit = true;
+            configCacheTimeSaved = computeTime - (double)(clock() - loadStartTime) / CLOCKS_PER_SEC;
+            EV_INFO << "Network configuration loaded from cache file " << configCacheFile << endl;
+            printElapsedTime("initialize", initializeStartTime);
+            return;
+        }
+    }
+    long computeStartTime = clock();
     // read the configuration from XML; it will serve as input for address assignment
     T(readInterfaceConfiguration(topology));
     // assign addresses to IPv4 nodes
@@ -115,9 +211,230 @@ void IPv4NetworkConfigurator::computeConfiguration()
     // calculate shortest paths, and add corresponding static routes
     if (addStaticRoutesParameter)
         T(addStaticRoutes(topology));
+    if (!configCacheFile.empty())
+        saveConfigCache(topology, configCacheFile.c_str(), configHash, (double)(clock() - computeStartTime) / CLOCKS_PER_SEC);
     printElapsedTime("initialize", initializeStartTime);
 }
 
+uint64 IPv4NetworkConfigurator::computeConfigurationHash(IPv4Topology& topology)
+{
+    uint64 hash = 14695981039346656037ULL;
+    hashBytes(hash, CONFIG_CACHE_MAGIC, sizeof(CONFIG_CACHE_MAGIC));
+
+    // parameters
+    hashValue(hash, assignAddressesParameter);
+    hashValue(hash, assignDisjunctSubnetAddressesParameter);
+    hashValue(hash, addStaticRoutesParameter);
+    hashValue(hash, addSubnetRoutesParameter);
+    hashValue(hash, addDefaultRoutesParameter);
+    hashValue(hash, optimizeRoutesParameter);
+    hashXML(hash, configuration);
+
+    // extracted topology: nodes with their interfaces and weighted links, and the links between interfaces
+    for (int i = 0; i < topology.getNumNodes(); i++)
+    {
+        Node *node = (Node *)topology.getNode(i);
+        hashString(hash, node->module->getFullPath());
+        hashValue(hash, node->getWeight());
+        for (int j = 0; j < (int)node->interfaceInfos.size(); j++)
+        {
+            InterfaceEntry *interfaceEntry = node->interfaceInfos[j]->interfaceEntry;
+            hashString(hash, interfaceEntry->getFullName());
+            hashValue(hash, interfaceEntry->getInterfaceId());
+        }
+        for (int j = 0; j < node->getNumOutLinks(); j++)
+        {
+            Topology::LinkOut *linkOut = node->getLinkOut(j);
+            hashValue(hash, linkOut->getWeight());
+            hashValue(hash, linkOut->getRemoteNode()->getModuleId());
+        }
+    }
+    for (int i = 0; i < (int)topology.linkInfos.size(); i++)
+    {
+        LinkInfo *linkInfo = topology.linkInfos[i];
+        for (int j = 0; j < (int)linkInfo->interfaceInfos.size(); j++)
+            hashString(hash, linkInfo->interfaceInfos[j]->getFullPath());
+        hashString(hash, linkInfo->gatewayInterfaceInfo ? linkInfo->gatewayInterfaceInfo->getFullPath() : "");
+    }
+    return hash;
+}
+
+std::string IPv4NetworkConfigurator::getConfigCacheFileName(uint64 hash)
+{
+    char name[32];
+    sprintf(name, "%016llx.ipv4config", (unsigned long long)hash);
+    return configCacheDir + "/" + name;
+}
+
+bool IPv4NetworkConfigurator::loadConfigCache(IPv4Topology& topology, const char *fileName, uint64 hash, double& computeTime)
+{
+    std::ifstream in(fileName, std::ios::in | std::ios::binary);
+    if (!in)
+        return false;
+
+    char magic[sizeof(CONFIG_CACHE_MAGIC)];
+    uint32 byteOrder;
+    uint64 fileHash;
+    int32 numNodes;
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, CONFIG_CACHE_MAGIC, sizeof(magic)) ||
+        !readValue(in, byteOrder) || byteOrder != CONFIG_CACHE_BYTE_ORDER ||
+        !readValue(in, fileHash) || fileHash != hash ||
+        !readValue(in, computeTime) || !readValue(in, numNodes) || numNodes != topology.getNumNodes())
+    {
+        EV_WARN << "Ignoring invalid or outdated configuration cache file " << fileName << endl;
+        return false;
+    }
+
+    // read everything before touching the topology, so that a truncated file changes nothing
+    std::vector<InterfaceInfo> interfaceInfos;
+    std::vector<std::vector<IPv4Route *> > staticRoutes(numNodes);
+    bool ok = true;
+    for (int i = 0; i < numNodes && ok; i++)
+    {
+        Node *node = (Node *)topology.getNode(i);
+        int32 numInterfaces;
+        ok = readValue(in, numInterfaces) && numInterfaces == (int32)node->interfaceInfos.size();
+        for (int j = 0; j < numInterfaces && ok; j++)
+        {
+            InterfaceInfo interfaceInfo(*node->interfaceInfos[j]);
+            uint8 configure;
+            int32 mtu, numMulticastGroups;
+            ok = readValue(in, configure) && readValue(in, mtu) && readValue(in, interfaceInfo.metric) &&
+                 readValue(in, interfaceInfo.address) && readValue(in, interfaceInfo.addressSpecifiedBits) &&
+                 readValue(in, interfaceInfo.netmask) && readValue(in, interfaceInfo.netmaskSpecifiedBits) &&
+                 readValue(in, numMulticastGroups) && numMulticastGroups >= 0;
+            interfaceInfo.configure = configure != 0;
+            interfaceInfo.mtu = mtu;
+            interfaceInfo.multicastGroups.clear();
+            for (int k = 0; k < numMulticastGroups && ok; k++)
+            {
+                uint32 group;
+                ok = readValue(in, group);
+                interfaceInfo.multicastGroups.push_back(IPv4Address(group));
+            }
+            interfaceInfos.push_back(interfaceInfo);
+        }
+        int32 numRoutes;
+        ok = ok && readValue(in, numRoutes) && numRoutes >= 0;
+        for (int j = 0; j < numRoutes && ok; j++)
+        {
+            uint32 destination, netmask, gateway;
+            int32 interfaceId, sourceType, metric;
+            ok = readValue(in, destination) && readValue(in, netmask) && readValue(in, gateway) &&
+                 readValue(in, interfaceId) && readValue(in, sourceType) && readValue(in, metric);
+            InterfaceEntry *interfaceEntry = ok && node->interfaceTable ? node->interfaceTable->getInterfaceById(interfaceId) : NULL;
+            if (!interfaceEntry)
+            {
+                ok = false;
+                break;
+            }
+            IPv4Route *route = new IPv4Route();
+            route->setDestination(IPv4Address(destination));
+            route->setNetmask(IPv4Address(netmask));
+            route->setGateway(IPv4Address(gateway));
+            route->setInterface(interfaceEntry);
+            route->setSourceType((IPv4Route::SourceType)sourceType);
+            route->setMetric(metric);
+            staticRoutes[i].push_back(route);
+        }
+    }
+    if (!ok)
+    {
+        EV_WARN << "Ignoring invalid configuration cache file " << fileName << endl;
+        for (int i = 0; i < numNodes; i++)
+            for (int j = 0; j < (int)staticRoutes[i].size(); j++)
+                delete staticRoutes[i][j];
+        return false;
+    }
+
+    int k = 0;
+    for (int i = 0; i < numNodes; i++)
+    {
+        Node *node = (Node *)topology.getNode(i);
+        for (int j = 0; j < (int)node->interfaceInfos.size(); j++, k++)
+        {
+            InterfaceInfo *interfaceInfo = node->interfaceInfos[j];
+            const InterfaceInfo& cachedInterfaceInfo = interfaceInfos[k];
+            interfaceInfo->configure = cachedInterfaceInfo.configure;
+            interfaceInfo->mtu = cachedInterfaceInfo.mtu;
+            interfaceInfo->metric = cachedInterfaceInfo.metric;
+            interfaceInfo->address = cachedInterfaceInfo.address;
+            interfaceInfo->addressSpecifiedBits = cachedInterfaceInfo.addressSpecifiedBits;
+            interfaceInfo->netmask = cachedInterfaceInfo.netmask;
+            interfaceInfo->netmaskSpecifiedBits = cachedInterfaceInfo.netmaskSpecifiedBits;
+            interfaceInfo->multicastGroups = cachedInterfaceInfo.multicastGroups;
+        }
+        node->staticRoutes = staticRoutes[i];
+    }
+    return true;
+}
+
+void IPv4NetworkConfigurator::saveConfigCache(IPv4Topology& topology, const char *fileName, uint64 hash, double computeTime)
+{
+    // multicast routes refer to several interfaces and are rare; such configurations are not cached
+    for (int i = 0; i < topology.getNumNodes(); i++)
+        if (!((Node *)topology.getNode(i))->staticMulticastRoutes.empty())
+            return;
+
+#ifdef _WIN32
+    _mkdir(configCacheDir.c_str());
+#else
+    mkdir(configCacheDir.c_str(), 0777);
+#endif
+    // write into a temporary file first, so that parallel runs never see a partially written file
+    std::string tmpFileName = std::string(fileName) + ".tmp." + cSimulation::getActiveSimulation()->getEnvir()->getConfigEx()->getVariable(CFGVAR_PROCESSID);
+    std::ofstream out(tmpFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        EV_WARN << "Cannot write configuration cache file " << tmpFileName << endl;
+        return;
+    }
+
+    out.write(CONFIG_CACHE_MAGIC, sizeof(CONFIG_CACHE_MAGIC));
+    writeValue(out, CONFIG_CACHE_BYTE_ORDER);
+    writeValue(out, hash);
+    writeValue(out, computeTime);
+    writeValue(out, (int32)topology.getNumNodes());
+    for (int i = 0; i < topology.getNumNodes(); i++)
+    {
+        Node *node = (Node *)topology.getNode(i);
+        writeValue(out, (int32)node->interfaceInfos.size());
+        for (int j = 0; j < (int)node->interfaceInfos.size(); j++)
+        {
+            InterfaceInfo *interfaceInfo = node->interfaceInfos[j];
+            writeValue(out, (uint8)interfaceInfo->configure);
+            writeValue(out, (int32)interfaceInfo->mtu);
+            writeValue(out, interfaceInfo->metric);
+            writeValue(out, interfaceInfo->address);
+            writeValue(out, interfaceInfo->addressSpecifiedBits);
+            writeValue(out, interfaceInfo->netmask);
+            writeValue(out, interfaceInfo->netmaskSpecifiedBits);
+            writeValue(out, (int32)interfaceInfo->multicastGroups.size());
+            for (int k = 0; k < (int)interfaceInfo->multicastGroups.size(); k++)
+                writeValue(out, interfaceInfo->multicastGroups[k].getInt());
+        }
+        writeValue(out, (int32)node->staticRoutes.size());
+        for (int j = 0; j < (int)node->staticRoutes.size(); j++)
+        {
+            IPv4Route *route = node->staticRoutes[j];
+            writeValue(out, route->getDestination().getInt());
+            writeValue(out, route->getNetmask().getInt());
+            writeValue(out, route->getGateway().getInt());
+            writeValue(out, (int32)route->getInterface()->getInterfaceId());
+            writeValue(out, (int32)route->getSourceType());
+            writeValue(out, (int32)route->getMetric());
+        }
+    }
+    out.close();
+    if (!out || rename(tmpFileName.c_str(), fileName) != 0)
+    {
+        EV_WARN << "Cannot write configuration cache file " << fileName << endl;
+        remove(tmpFileName.c_str());
+    }
+    else
+        EV_INFO << "Network configuration saved to cache file " << fileName << endl;
+}
+
 void IPv4NetworkConfigurator::ensureConfigurationComputed(IPv4Topology& topology)
 {
     if (topology.getNumNodes() == 0)
@@ -1877,73 +2194,6 @@ int IPv4NetworkConfigurator::findRouteIndexWithSameColor(const std::vector<IPv4R
     return -1;
 }
 
-/**
- * Returns true if swapping two ADJACENT routes in the routing table does not change the table's meaning.
- */
-bool IPv4NetworkConfigurator::routesCanBeSwapped(RouteInfo *routeInfo1, RouteInfo *routeInfo2)
-{
-    if (routeInfo1->color == routeInfo2->color)
-        return true;  // these two routes send the packet in the same direction (same gw/iface), doesn't matter which one we use -> can be swapped
-    else {
-        // unrelated routes can also be swapped
-        uint32 netmask = routeInfo1->netmask & routeInfo2->netmask;
-        return (routeInfo1->destination & netmask) != (routeInfo2->destination & netmask);
-    }
-}
-
-/**
- * Returns true if the routes can be neighbors by repeatedly swapping routes
- * in the routing table without changing their meaning.
- */
-bool IPv4NetworkConfigurator::routesCanBeNeighbors(const std::vector<RouteInfo *>& routeInfos, int i, int j)
-{
-    int begin = std::min(i, j);
-    int end = std::max(i, j);
-    IPv4NetworkConfigurator::RouteInfo *beginRouteInfo = routeInfos.at(begin);
-    for (int index = begin + 1; index < end; index++)
-        if (!routesCanBeSwapped(beginRouteInfo, routeInfos.at(index)))
-            return false;
-    return true;
-}
-
-/**
- * Returns true if the original route is interrupted by any of the routes in
- * the routing table between begin and end.
- */
-bool IPv4NetworkConfigurator::interruptsOriginalRoute(const RoutingTableInfo& routingTableInfo, int begin, int end, RouteInfo *originalRouteInfo)
-{
-    IPv4NetworkConfigurator::RouteInfo *matchingRouteInfo = routingTableInfo.findBestMatchingRouteInfo(originalRouteInfo->destination, begin, end);
-    return matchingRouteInfo && matchingRouteInfo->color != originalRouteInfo->color;
-}
-
-/**
- * Returns true if any of the original routes is interrupted by any of the
- * routes in the routing table between begin and end.
- */
-bool IPv4NetworkConfigurator::interruptsAnyOriginalRoute(const RoutingTableInfo& routingTableInfo, int begin, int end, const std::vector<RouteInfo *>& originalRouteInfos)
-{
-    if (begin < end)
-        for (int i = 0; i < (int)originalRouteInfos.size(); i++)
-            if (interruptsOriginalRoute(routingTableInfo, begin, end, originalRouteInfos.at(i)))
-                return true;
-    return false;
-}
-
-/**
- * Returns true if any of the original routes attached to the routes in the
- * routing table below index are interrupted by the route at index.
- */
-bool IPv4NetworkConfigurator::interruptsSubsequentOriginalRoutes(const RoutingTableInfo& routingTableInfo, int index)
-{
-    for (int i = index + 1; i < (int)routingTableInfo.routeInfos.size(); i++)
-    {
-        IPv4NetworkConfigurator::RouteInfo *routeInfo = routingTableInfo.routeInfos.at(i);
-        if (interruptsAnyOriginalRoute(routingTableInfo, index, index + 1, routeInfo->originalRouteInfos))
-            return true;
-    }
-    return false;
-}
-
 /**
  * Asserts that all original routes are still routed the same way as by the original routing table.
  */
@@ -1960,170 +2210,120 @@ void IPv4NetworkConfigurator::checkOriginalRoutes(const RoutingTableInfo& routin
 }
 
 /**
- * Returns the longest shared address prefix and netmask by iterating through bits from left to right.
+ * Inserts the original routes into the binary trie, one node per prefix.
+ * If two original routes have the same prefix, the first one wins, just
+ * like in the routing table.
  */
-void IPv4NetworkConfigurator::findLongestCommonDestinationPrefix(uint32 destination1, uint32 netmask1, uint32 destination2, uint32 netmask2, uint32& destinationOut, uint32& netmaskOut)
+void IPv4NetworkConfigurator::buildRouteTrie(std::vector<RouteTrieNode>& trie, const std::vector<RouteInfo *>& originalRouteInfos)
 {
-    netmaskOut = 0;
-    destinationOut = 0;
-    for (int bitIndex = 31; bitIndex >= 0; bitIndex--)
+    trie.clear();
+    trie.push_back(RouteTrieNode());
+    for (int i = 0; i < (int)originalRouteInfos.size(); i++)
     {
-        uint32 mask = 1 << bitIndex;
-        if ((destination1 & mask) == (destination2 & mask) &&
-            (netmask1 & mask) != 0 && (netmask2 & mask) != 0)
+        RouteInfo *originalRouteInfo = originalRouteInfos.at(i);
+        int netmaskLength = IPv4Address(originalRouteInfo->netmask).getNetmaskLength();
+        int index = 0;
+        for (int depth = 0; depth < netmaskLength; depth++)
         {
-            netmaskOut |= mask;
-            destinationOut |= destination1 & mask;
+            int bit = (originalRouteInfo->destination >> (31 - depth)) & 1;
+            if (trie[index].child[bit] == -1)
+            {
+                trie[index].child[bit] = trie.size();
+                trie.push_back(RouteTrieNode());
+            }
+            index = trie[index].child[bit];
         }
-        else
-            break;
+        if (trie[index].color == -1)
+            trie[index].color = originalRouteInfo->color;
     }
 }
 
 /**
- * Adds all of the original routes to the matching optimized routes between begin and end.
+ * First two passes of ORTC: pushes the routes down to the leaves of the trie
+ * (so that every node has zero or two children), and computes the set of
+ * colors each node could be routed with, bottom up. Addresses that are not
+ * routed by any of the original routes are "don't care": they may be routed
+ * any way, which allows more aggressive merging.
  */
-void IPv4NetworkConfigurator::addOriginalRouteInfos(RoutingTableInfo& routingTableInfo, int begin, int end, const std::vector<RouteInfo *>& originalRouteInfos)
+void IPv4NetworkConfigurator::computeRouteTrieColors(std::vector<RouteTrieNode>& trie, int index, int inheritedColor)
 {
-    for (int i = 0; i < (int)originalRouteInfos.size(); i++)
+    if (trie[index].color != -1)
+        inheritedColor = trie[index].color;
+    if (trie[index].child[0] == -1 && trie[index].child[1] == -1)
     {
-        IPv4NetworkConfigurator::RouteInfo *originalRouteInfo = originalRouteInfos.at(i);
-        IPv4NetworkConfigurator::RouteInfo *matchingRouteInfo = routingTableInfo.findBestMatchingRouteInfo(originalRouteInfo->destination, begin, end);
-        ASSERT(matchingRouteInfo && matchingRouteInfo->color == originalRouteInfo->color);
-        matchingRouteInfo->originalRouteInfos.push_back(originalRouteInfo);
+        if (inheritedColor == -1)
+            trie[index].dontCare = true;
+        else
+            trie[index].colors.push_back(inheritedColor);
+        return;
     }
-}
-
-/**
- * Try to merge two routes that have the same color and could be neighbours in table
- * without changing the table's meaning. There are two merge opportunities:
- * (1) one route's network contains the other one (then the second can be dropped),
- * and (2) use a shorter common prefix that covers both (this is only possible
- * if this doesn't interfere with existing routes in the table).
- * Returns true if the two routes have been merged, otherwise returns false.
- */
-bool IPv4NetworkConfigurator::tryToMergeTwoRoutes(RoutingTableInfo& routingTableInfo, int i, int j, RouteInfo *routeInfoI, RouteInfo *routeInfoJ)
-{
-    // determine longest shared address prefix and netmask by iterating through bits from left to right
-    uint32 netmask;
-    uint32 destination;
-    findLongestCommonDestinationPrefix(routeInfoI->destination, routeInfoI->netmask, routeInfoJ->destination, routeInfoJ->netmask, destination, netmask);
-
-    // create the merged route
-    RouteInfo *mergedRouteInfo = new RouteInfo(routeInfoI->color, destination, netmask);
-    routeInfoI->enabled = false;
-    routeInfoJ->enabled = false;
-    int m = routingTableInfo.addRouteInfo(mergedRouteInfo);
-    ASSERT(m > i && m > j);
-
-    // check if all the original routes are still routed the same way by the optimized routing table.
-    // check optimization: instead of checking all the original routes, check only those which can go wrong due to the merge.
-    // (assuming the previous configuration was correct)
-    //  - the original routes on I and J are going to be routed by M after the merge, so check if the routes in between don't interrupt them
-    //  - the original routes following M can be accidentally overridden by M (being larger than the sum of I and J), so verify that M does not interrupt them
-    // note that the condition is not symmetric because I follows J so it requires fewer checks and we do use that.
-    if (!interruptsAnyOriginalRoute(routingTableInfo, j + 1, i, routeInfoJ->originalRouteInfos) && // check that original routes on J are not interrupted between J and I
-        !interruptsAnyOriginalRoute(routingTableInfo, i + 1, m, routeInfoJ->originalRouteInfos) && // check that original routes on J are not interrupted between I and M
-        !interruptsAnyOriginalRoute(routingTableInfo, i + 1, m, routeInfoI->originalRouteInfos) && // check that original routes on I are not interrupted between I and M
-        !interruptsSubsequentOriginalRoutes(routingTableInfo, m)) // check that the original routes after M are not interrupted by M
-    {
-        // now we know that the merge does not conflict with any route in the routing table.
-        // the next thing to do is to maintain the original routes attached to the optimized ones.
-        // move original routes from the to be deleted I route to the capturing routes.
-        addOriginalRouteInfos(routingTableInfo, i + 1, m + 1, routeInfoI->originalRouteInfos);
-
-        // move original routes from the to be deleted J route to the capturing routes.
-        addOriginalRouteInfos(routingTableInfo, j + 1, m + 1, routeInfoJ->originalRouteInfos);
-
-        // move original routes from the routes following the merged one if necessary.
-        for (int k = m + 1; k < (int)routingTableInfo.routeInfos.size(); k++)
+    for (int bit = 0; bit < 2; bit++)
+    {
+        if (trie[index].child[bit] == -1)
         {
-            IPv4NetworkConfigurator::RouteInfo *followingRouteInfo = routingTableInfo.routeInfos.at(k);
-            for (int l = 0; l < (int)followingRouteInfo->originalRouteInfos.size(); l++)
-            {
-                IPv4NetworkConfigurator::RouteInfo *originalRouteInfo = followingRouteInfo->originalRouteInfos.at(l);
-                if (!((originalRouteInfo->destination ^ mergedRouteInfo->destination) & mergedRouteInfo->netmask))
-                {
-                    followingRouteInfo->originalRouteInfos.erase(followingRouteInfo->originalRouteInfos.begin() + l);
-                    ASSERT(mergedRouteInfo->color == originalRouteInfo->color);
-                    mergedRouteInfo->originalRouteInfos.push_back(originalRouteInfo);
-                    l--;
-                }
-            }
+            // note: push_back may invalidate references into the trie
+            trie[index].child[bit] = trie.size();
+            trie.push_back(RouteTrieNode());
         }
-        routingTableInfo.removeRouteInfo(routeInfoI);
-        routingTableInfo.removeRouteInfo(routeInfoJ);
-#ifndef NDEBUG
-        //checkOriginalRoutes(routingTableInfo, originalRouteInfos);
-#endif
-        delete routeInfoI;
-        delete routeInfoJ;
-        return true;
-    }
+        computeRouteTrieColors(trie, trie[index].child[bit], inheritedColor);
+    }
+    const RouteTrieNode& child0 = trie[trie[index].child[0]];
+    const RouteTrieNode& child1 = trie[trie[index].child[1]];
+    RouteTrieNode& node = trie[index];
+    if (child0.dontCare && child1.dontCare)
+        node.dontCare = true;
+    else if (child0.dontCare)
+        node.colors = child1.colors;
+    else if (child1.dontCare)
+        node.colors = child0.colors;
     else
     {
-        // merge failed; restore original state
-        routeInfoI->enabled = true;
-        routeInfoJ->enabled = true;
-        routingTableInfo.removeRouteInfo(mergedRouteInfo);
-        delete mergedRouteInfo;
-        return false;
+        std::set_intersection(child0.colors.begin(), child0.colors.end(), child1.colors.begin(), child1.colors.end(), std::back_inserter(node.colors));
+        if (node.colors.empty())
+            std::set_union(child0.colors.begin(), child0.colors.end(), child1.colors.begin(), child1.colors.end(), std::back_inserter(node.colors));
     }
 }
 
 /**
- * Iteratively checks if any two routes can be aggressively merged without changing the meaning of all original routes.
- * The merged route will have the longest shared address prefix and netmask with the two merged routes.
- * This optimization might change the meaning of the routing table in that it will route packets that it did not route before.
- * Nevertheless, any packet routed by the original routing table will still be routed the same way by the optimized routing table.
- * Returns true if two routes has been merged, otherwise returns false.
+ * Last pass of ORTC: walks the trie top down, and adds a route wherever the
+ * color inherited from the nearest enclosing route is not acceptable.
  */
-bool IPv4NetworkConfigurator::tryToMergeAnyTwoRoutes(RoutingTableInfo& routingTableInfo)
+void IPv4NetworkConfigurator::collectOptimizedRoutes(const std::vector<RouteTrieNode>& trie, int index, int depth, uint32 destination, int inheritedColor, RoutingTableInfo& routingTableInfo)
 {
-    for (int i = 0; i < (int)routingTableInfo.routeInfos.size(); i++)
+    const RouteTrieNode& node = trie[index];
+    if (!node.dontCare && (inheritedColor == -1 || !std::binary_search(node.colors.begin(), node.colors.end(), inheritedColor)))
     {
-        IPv4NetworkConfigurator::RouteInfo *routeInfoI = routingTableInfo.routeInfos.at(i);
-
-        // iterate backward so that we try to merge routes having longer netmasks first.
-        // this results in smaller changes and allows more symmetric optimization.
-        for (int j = i - 1; j >= 0; j--)
-        {
-            IPv4NetworkConfigurator::RouteInfo *routeInfoJ = routingTableInfo.routeInfos.at(j);
-
-            // we can only merge neighbor routes having the same color
-            if (routeInfoI->color == routeInfoJ->color && routesCanBeNeighbors(routingTableInfo.routeInfos, i, j))
-            {
-                // it is worth to actually try to merge them
-                if (tryToMergeTwoRoutes(routingTableInfo, i, j, routeInfoI, routeInfoJ))
-                    return true;
-            }
-        }
+        inheritedColor = node.colors.front();
+        routingTableInfo.addRouteInfo(new RouteInfo(inheritedColor, destination, IPv4Address::makeNetmask(depth).getInt()));
     }
-    return false;
+    for (int bit = 0; bit < 2; bit++)
+        if (node.child[bit] != -1)
+            collectOptimizedRoutes(trie, node.child[bit], depth + 1, destination | ((uint32)bit << (31 - depth)), inheritedColor, routingTableInfo);
 }
 
 void IPv4NetworkConfigurator::optimizeRoutes(std::vector<IPv4Route *>& originalRoutes)
 {
-    // The basic idea: if two routes "do the same" (same output interface, gateway, etc) and
-    // match "similar" addresses, one can try to move them to be neighbors in the table and
-    // replace them with a single route which contains their longest common prefix as address
-    // prefix -- provided that this operation doesn't affect the meaning of the routing table
-    // for "existing" addresses. (We don't care about changing the routing for addresses that
-    // we know don't occur in our currently configured network.) We can repeatedly merge routes
-    // in this way until it's not possible any more. Of course, the result also depends on
-    // which pairs of routes we merge, and in which order.
+    // The basic idea: routes that "do the same" (same output interface, gateway, etc) get the
+    // same color, and the optimizer looks for the smallest routing table (in number of routes)
+    // that routes every address the same way as the original routes do. Addresses that are
+    // not routed by the original routes don't matter (we don't care about changing the routing
+    // for addresses that we know don't occur in our currently configured network), so these
+    // may end up being routed by the optimized table. This is the ORTC algorithm (Draves et al.,
+    // "Constructing Optimal IP Routing Tables") with "don't care" addresses, running on a binary
+    // trie of the route prefixes in time linear in the number of routes.
 
     // STEP 1.
     // instead of working with IPv4 routes we transform them into the internal representation of the optimizer.
     // routes are classified based on their action (gateway, interface, type, source, metric, etc.) and a color is assigned to them.
-    RoutingTableInfo routingTableInfo;
     std::vector<IPv4Route *> colorToRoute;  // a mapping from color to route action (interface, gateway, metric, etc.)
     std::vector<RouteInfo *> originalRouteInfos; // a copy of the original routes in the optimizer's format
 
-    // build colorToRouteColor, originalRouteInfos and initial routeInfos in routingTableInfo
+    // build colorToRouteColor and originalRouteInfos
     for (int i = 0; i < (int)originalRoutes.size(); i++)
     {
         IPv4Route *originalRoute = originalRoutes.at(i);
+        if (!originalRoute->getNetmask().isValidNetmask())
+            throw cRuntimeError("Cannot optimize routes: route %s has a non-contiguous netmask", originalRoute->info().c_str());
         int color = findRouteIndexWithSameColor(colorToRoute, originalRoute);
         if (color == -1)
         {
@@ -2134,25 +2334,22 @@ void IPv4NetworkConfigurator::optimizeRoutes(std::vector<IPv4Route *>& originalR
         // create original route and determine its color
         RouteInfo *originalRouteInfo = new RouteInfo(color, originalRoute->getDestination().getInt(), originalRoute->getNetmask().getInt());
         originalRouteInfos.push_back(originalRouteInfo);
-
-        // create a copy of the original route that can be destructively optimized later
-        RouteInfo *optimizedRouteInfo = new RouteInfo(*originalRouteInfo);
-        optimizedRouteInfo->originalRouteInfos.push_back(originalRouteInfo);
-        routingTableInfo.addRouteInfo(optimizedRouteInfo);
     }
 
-#ifndef NDEBUG
-    checkOriginalRoutes(routingTableInfo, originalRouteInfos);
-#endif
-
     // STEP 2.
     // from now on we are only working with the internal data structures called RouteInfo and RoutingTableInfo.
-    // the main optimizer loop runs until it cannot merge any two routes.
-    while (tryToMergeAnyTwoRoutes(routingTableInfo));
+    // build the trie of original routes, compute the possible colors for each prefix, and select the routes.
+    std::vector<RouteTrieNode> trie;
+    buildRouteTrie(trie, originalRouteInfos);
+    computeRouteTrieColors(trie, 0, -1);
+    RoutingTableInfo routingTableInfo;
+    collectOptimizedRoutes(trie, 0, 0, 0, -1, routingTableInfo);
 
 #ifndef NDEBUG
     checkOriginalRoutes(routingTableInfo, originalRouteInfos);
 #endif
+    for (int i = 0; i < (int)originalRouteInfos.size(); i++)
+        delete originalRouteInfos.at(i);
 
     // STEP 3.
     // convert the optimized routes to new optimized IPv4 routes based on the saved colors
@@ -142,7 +142,6 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule, public IPvXAddres
                 bool enabled;       // allows turning of routes without removing them from the list
                 uint32 destination; // originally copied from the IPv4Route
                 uint32 netmask;     // originally copied from the IPv4Route
-                std::vector<RouteInfo *> originalRouteInfos; // routes that are routed by this one from the unoptimized original routing table, we keep track of this to be able to skip merge candidates with less computation
 
             public:
                 RouteInfo(int color, uint32 destination, uint32 netmask) { this->color = color; this->enabled = true; this->destination = destination; this->netmask = netmask; }
@@ -163,6 +162,20 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule, public IPvXAddres
                 static bool routeInfoLessThan(const RouteInfo *a, const RouteInfo *b) { return a->netmask != b->netmask ? a->netmask > b->netmask : a->destination < b->destination; }
         };
 
+        /**
+         * Node of the binary trie of route prefixes used by the optimizer.
+         */
+        class RouteTrieNode {
+            public:
+                int child[2];            // indices of the child nodes in the trie, or -1
+                int color;               // color of the original route with exactly this prefix, or -1
+                bool dontCare;           // no original route covers this prefix, it may be routed any way
+                std::vector<int> colors; // sorted set of colors this prefix may be routed with
+
+            public:
+                RouteTrieNode() { child[0] = child[1] = -1; color = -1; dontCare = false; }
+        };
+
         class Matcher
         {
             protected:
@@ -201,10 +214,15 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule, public IPvXAddres
         bool addDefaultRoutesParameter;
         bool optimizeRoutesParameter;
         cXMLElement *configuration;
+        std::string configCacheDir;
 
         // internal state
         IPv4Topology topology;
 
+        // statistics
+        bool configCacheHit;
+        double configCacheTimeSaved;
+
     public:
         /**
          * Computes the IPv4 network configuration for all nodes in the network.
@@ -236,6 +254,31 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule, public IPvXAddres
         virtual int numInitStages() const  { return 4; }
         virtual void handleMessage(cMessage *msg) { throw cRuntimeError("this module doesn't handle messages, it runs only in initialize()"); }
         virtual void initialize(int stage);
+        virtual void finish();
+
+        /**
+         * Computes a hash of everything the network configuration depends on: the
+         * module parameters, the XML configuration and the extracted topology.
+         */
+        virtual uint64 computeConfigurationHash(IPv4Topology& topology);
+
+        /**
+         * Returns the name of the configuration cache file for the given hash.
+         */
+        virtual std::string getConfigCacheFileName(uint64 hash);
+
+        /**
+         * Restores interface configurations and static routes from a configuration
+         * cache file written by a previous run. Returns false and leaves the topology
+         * unchanged if the file does not exist, is corrupt or belongs to another hash.
+         */
+        virtual bool loadConfigCache(IPv4Topology& topology, const char *fileName, uint64 hash, double& computeTime);
+
+        /**
+         * Writes the computed interface configurations and static routes into a
+         * configuration cache file. Failures are reported as warnings only.
+         */
+        virtual void saveConfigCache(IPv4Topology& topology, const char *fileName, uint64 hash, double computeTime);
 
         /**
          * Extracts network topology by walking through the module hierarchy.
@@ -331,16 +374,10 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule, public IPvXAddres
         bool containsRoute(const std::vector<IPv4Route *>& routes, IPv4Route *route);
         bool routesHaveSameColor(IPv4Route *route1, IPv4Route *route2);
         int findRouteIndexWithSameColor(const std::vector<IPv4Route *>& routes, IPv4Route *route);
-        bool routesCanBeSwapped(RouteInfo *routeInfo1, RouteInfo *routeInfo2);
-        bool routesCanBeNeighbors(const std::vector<RouteInfo *>& routeInfos, int i, int j);
-        bool interruptsOriginalRoute(const RoutingTableInfo& routingTableInfo, int begin, int end, RouteInfo *originalRouteInfo);
-        bool interruptsAnyOriginalRoute(const RoutingTableInfo& routingTableInfo, int begin, int end, const std::vector<RouteInfo *>& originalRouteInfos);
-        bool interruptsSubsequentOriginalRoutes(const RoutingTableInfo& routingTableInfo, int index);
         void checkOriginalRoutes(const RoutingTableInfo& routingTableInfo, const std::vector<RouteInfo *>& originalRouteInfos);
-        void findLongestCommonDestinationPrefix(uint32 destination1, uint32 netmask1, uint32 destination2, uint32 netmask2, uint32& destinationOut, uint32& netmaskOut);
-        void addOriginalRouteInfos(RoutingTableInfo& routingTableInfo, int begin, int end, const std::vector<RouteInfo *>& originalRouteInfos);
-        bool tryToMergeTwoRoutes(RoutingTableInfo& routingTableInfo, int i, int j, RouteInfo *routeInfoI, RouteInfo *routeInfoJ);
-        bool tryToMergeAnyTwoRoutes(RoutingTableInfo& routingTableInfo);
+        void buildRouteTrie(std::vector<RouteTrieNode>& trie, const std::vector<RouteInfo *>& originalRouteInfos);
+        void computeRouteTrieColors(std::vector<RouteTrieNode>& trie, int index, int inheritedColor);
+        void collectOptimizedRoutes(const std::vector<RouteTrieNode>& trie, int index, int depth, uint32 destination, int inheritedColor, RoutingTableInfo& routingTableInfo);
 
     public:
         // address resolver interface
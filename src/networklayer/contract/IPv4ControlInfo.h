@@ -18,6 +18,7 @@
 #ifndef __INET_IPv4CONTROLINFO_H
 #define __INET_IPv4CONTROLINFO_H
 
+#include "ObjectPool.h"
 #include "IPv4ControlInfo_m.h"
 
 class IPv4Datagram;
@@ -29,6 +30,8 @@ class IPv4Datagram;
  */
 class INET_API IPv4ControlInfo : public IPv4ControlInfo_Base
 {
+    INET_POOLED_ALLOCATION(IPv4ControlInfo)
+
   protected:
     IPv4Datagram *dgram;
 
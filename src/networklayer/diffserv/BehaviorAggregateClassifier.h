@@ -22,10 +22,12 @@
 
 #include "INETDefs.h"
 
+#include "FusedModuleBase.h"
+
 /**
  * Behavior Aggregate Classifier.
  */
-class INET_API BehaviorAggregateClassifier : public cSimpleModule
+class INET_API BehaviorAggregateClassifier : public FusedModuleBase
 {
   protected:
     int numOutGates;
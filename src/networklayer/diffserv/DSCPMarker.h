@@ -21,10 +21,12 @@
 
 #include "INETDefs.h"
 
+#include "FusedModuleBase.h"
+
 /**
  * DSCP Marker.
  */
-class INET_API DSCPMarker : public cSimpleModule
+class INET_API DSCPMarker : public FusedModuleBase
 {
   protected:
     std::vector<int> dscps;
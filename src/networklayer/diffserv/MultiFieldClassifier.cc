@@ -39,113 +39,146 @@
 #include "MultiFieldClassifier.h"
 #include "DiffservUtil.h"
 
+#include <algorithm>
+
 using namespace DiffservUtil;
 
-#ifdef WITH_IPv4
-bool MultiFieldClassifier::Filter::matches(IPv4Datagram *datagram)
+static bool addressMatches(bool isIPv6, const IPvXAddress& address, const IPvXAddress& prefix, int prefixLength)
 {
-    if (srcPrefixLength > 0 && (srcAddr.isIPv6() || !datagram->getSrcAddress().prefixMatches(srcAddr.get4(), srcPrefixLength)))
-        return false;
-    if (destPrefixLength > 0 && (destAddr.isIPv6() || !datagram->getDestAddress().prefixMatches(destAddr.get4(), destPrefixLength)))
-        return false;
-    if (protocol >= 0 && datagram->getTransportProtocol() != protocol)
-        return false;
-    if (tosMask != 0 && (tos & tosMask) != (datagram->getTypeOfService() & tosMask))
-        return false;
-    if (srcPortMin >= 0 || destPortMin >= 0)
-    {
-        int srcPort = -1, destPort = -1;
-        cPacket *packet = datagram->getEncapsulatedPacket();
-#ifdef WITH_UDP
-        UDPPacket *udpPacket = dynamic_cast<UDPPacket*>(packet);
-        if (udpPacket)
-        {
-            srcPort = udpPacket->getSourcePort();
-            destPort = udpPacket->getDestinationPort();
-        }
-#endif
-#ifdef WITH_TCP_COMMON
-        TCPSegment *tcpSegment = dynamic_cast<TCPSegment*>(packet);
-        if (tcpSegment)
-        {
-            srcPort = tcpSegment->getSrcPort();
-            destPort = tcpSegment->getDestPort();
-        }
-#endif
+    if (isIPv6)
+        return prefix.isIPv6() && address.get6().matches(prefix.get6(), prefixLength);
+    else
+        return !prefix.isIPv6() && address.get4().prefixMatches(prefix.get4(), prefixLength);
+}
 
-        if (srcPortMin >= 0 && (srcPort < srcPortMin || srcPort > srcPortMax))
-            return false;
-        if (destPortMin >= 0 && (destPort < destPortMin || destPort > destPortMax))
-            return false;
-    }
+static IPvXAddress maskAddress(bool isIPv6, const IPvXAddress& address, int prefixLength)
+{
+    if (isIPv6)
+        return IPvXAddress(address.get6().getPrefix(std::min(prefixLength, 128)));
+    else
+        return IPvXAddress(address.get4().doAnd(IPv4Address::makeNetmask(std::min(prefixLength, 32))));
+}
 
-    return true;
+bool MultiFieldClassifier::PacketFields::operator<(const PacketFields& other) const
+{
+    if (isIPv6 != other.isIPv6)
+        return isIPv6 < other.isIPv6;
+    if (srcAddr != other.srcAddr)
+        return srcAddr < other.srcAddr;
+    if (destAddr != other.destAddr)
+        return destAddr < other.destAddr;
+    if (protocol != other.protocol)
+        return protocol < other.protocol;
+    if (tos != other.tos)
+        return tos < other.tos;
+    if (srcPort != other.srcPort)
+        return srcPort < other.srcPort;
+    return destPort < other.destPort;
 }
-#endif
 
-#ifdef WITH_IPv6
-bool MultiFieldClassifier::Filter::matches(IPv6Datagram *datagram)
+bool MultiFieldClassifier::Filter::matches(const PacketFields& fields) const
 {
-    if (srcPrefixLength > 0 && (!srcAddr.isIPv6() || !datagram->getSrcAddress().matches(srcAddr.get6(), srcPrefixLength)))
+    if (srcPrefixLength > 0 && !addressMatches(fields.isIPv6, fields.srcAddr, srcAddr, srcPrefixLength))
         return false;
-    if (destPrefixLength > 0 && (!destAddr.isIPv6() || !datagram->getDestAddress().matches(destAddr.get6(), destPrefixLength)))
+    if (destPrefixLength > 0 && !addressMatches(fields.isIPv6, fields.destAddr, destAddr, destPrefixLength))
         return false;
-    if (protocol >= 0 && datagram->getTransportProtocol() != protocol)
+    if (protocol >= 0 && fields.protocol != protocol)
         return false;
-    if (tosMask != 0 && (tos & tosMask) != (datagram->getTrafficClass() & tosMask))
+    if (tosMask != 0 && (tos & tosMask) != (fields.tos & tosMask))
         return false;
-    if (srcPortMin >= 0 || destPortMin >= 0)
-    {
-        int srcPort = -1, destPort = -1;
-        cPacket *packet = datagram->getEncapsulatedPacket();
-#ifdef WITH_UDP
-        UDPPacket *udpPacket = dynamic_cast<UDPPacket*>(packet);
-        if (udpPacket)
-        {
-            srcPort = udpPacket->getSourcePort();
-            destPort = udpPacket->getDestinationPort();
-        }
-#endif
-#ifdef WITH_TCP_COMMON
-        TCPSegment *tcpSegment = dynamic_cast<TCPSegment*>(packet);
-        if (tcpSegment)
-        {
-            srcPort = tcpSegment->getSrcPort();
-            destPort = tcpSegment->getDestPort();
-        }
-#endif
+    if (srcPortMin >= 0 && (fields.srcPort < srcPortMin || fields.srcPort > srcPortMax))
+        return false;
+    if (destPortMin >= 0 && (fields.destPort < destPortMin || fields.destPort > destPortMax))
+        return false;
+    return true;
+}
 
-        if (srcPortMin >= 0 && (srcPort < srcPortMin || srcPort > srcPortMax))
-            return false;
-        if (destPortMin >= 0 && (destPort < destPortMin || destPort > destPortMax))
-            return false;
-    }
+MultiFieldClassifier::FilterTuple::FilterTuple(const Filter& filter)
+{
+    srcPrefixLength = filter.srcPrefixLength;
+    srcIPv6 = srcPrefixLength > 0 && filter.srcAddr.isIPv6();
+    destPrefixLength = filter.destPrefixLength;
+    destIPv6 = destPrefixLength > 0 && filter.destAddr.isIPv6();
+    hasProtocol = filter.protocol >= 0;
+    tosMask = filter.tosMask;
+    // port ranges are not part of the lookup key, they are checked when the filter is verified
+    exactSrcPort = filter.srcPortMin >= 0 && filter.srcPortMin == filter.srcPortMax;
+    exactDestPort = filter.destPortMin >= 0 && filter.destPortMin == filter.destPortMax;
+}
 
-    return true;
+bool MultiFieldClassifier::FilterTuple::operator<(const FilterTuple& other) const
+{
+    if (srcPrefixLength != other.srcPrefixLength)
+        return srcPrefixLength < other.srcPrefixLength;
+    if (srcIPv6 != other.srcIPv6)
+        return srcIPv6 < other.srcIPv6;
+    if (destPrefixLength != other.destPrefixLength)
+        return destPrefixLength < other.destPrefixLength;
+    if (destIPv6 != other.destIPv6)
+        return destIPv6 < other.destIPv6;
+    if (hasProtocol != other.hasProtocol)
+        return hasProtocol < other.hasProtocol;
+    if (tosMask != other.tosMask)
+        return tosMask < other.tosMask;
+    if (exactSrcPort != other.exactSrcPort)
+        return exactSrcPort < other.exactSrcPort;
+    return exactDestPort < other.exactDestPort;
+}
+
+bool MultiFieldClassifier::FilterTuple::isApplicable(const PacketFields& fields) const
+{
+    return (srcPrefixLength == 0 || srcIPv6 == fields.isIPv6) &&
+           (destPrefixLength == 0 || destIPv6 == fields.isIPv6);
+}
+
+MultiFieldClassifier::PacketFields MultiFieldClassifier::FilterTuple::makeKey(const PacketFields& fields) const
+{
+    PacketFields key;
+    key.isIPv6 = (srcPrefixLength > 0 && srcIPv6) || (destPrefixLength > 0 && destIPv6);
+    if (srcPrefixLength > 0)
+        key.srcAddr = maskAddress(srcIPv6, fields.srcAddr, srcPrefixLength);
+    if (destPrefixLength > 0)
+        key.destAddr = maskAddress(destIPv6, fields.destAddr, destPrefixLength);
+    key.protocol = hasProtocol ? fields.protocol : -1;
+    key.tos = fields.tos & tosMask;
+    key.srcPort = exactSrcPort ? fields.srcPort : -1;
+    key.destPort = exactDestPort ? fields.destPort : -1;
+    return key;
 }
-#endif
 
 
 Define_Module(MultiFieldClassifier);
 
 simsignal_t MultiFieldClassifier::pkClassSignal = registerSignal("pkClass");
+simsignal_t MultiFieldClassifier::classificationCostSignal = registerSignal("classificationCost");
+simsignal_t MultiFieldClassifier::flowCacheHitSignal = registerSignal("flowCacheHit");
 
 
 void MultiFieldClassifier::initialize(int stage)
 {
-    cSimpleModule::initialize(stage);
+    FusedModuleBase::initialize(stage);
 
     if (stage == 0)
     {
         numOutGates = gateSize("outs");
+        compileFilters = par("compileFilters").boolValue();
+        int cacheSize = par("flowCacheSize");
+        if (cacheSize < 0)
+            throw cRuntimeError("flowCacheSize must not be negative");
+        flowCacheSize = cacheSize;
 
         numRcvd = 0;
+        numFlowCacheHits = numFlowCacheMisses = 0;
         WATCH(numRcvd);
+        WATCH(numFlowCacheHits);
+        WATCH(numFlowCacheMisses);
     }
     else if (stage == 3)
     {
         cXMLElement *config = par("filters").xmlValue();
         configureFilters(config);
+        if (compileFilters)
+            buildTupleSpace();
     }
 }
 
@@ -158,9 +191,9 @@ void MultiFieldClassifier::handleMessage(cMessage *msg)
     emit(pkClassSignal, gateIndex);
 
     if (gateIndex >= 0)
-        send(packet, "outs", gateIndex);
+        sendFused(packet, "outs", gateIndex);
     else
-        send(packet, "defaultOut");
+        sendFused(packet, "defaultOut");
 
     if (ev.isGUI())
     {
@@ -170,7 +203,7 @@ void MultiFieldClassifier::handleMessage(cMessage *msg)
     }
 }
 
-int MultiFieldClassifier::classifyPacket(cPacket *packet)
+bool MultiFieldClassifier::extractFields(cPacket *packet, PacketFields& fields)
 {
     for (; packet; packet = packet->getEncapsulatedPacket())
     {
@@ -178,25 +211,153 @@ int MultiFieldClassifier::classifyPacket(cPacket *packet)
         IPv4Datagram *ipv4Datagram = dynamic_cast<IPv4Datagram*>(packet);
         if (ipv4Datagram)
         {
-            for (std::vector<Filter>::iterator it = filters.begin(); it != filters.end(); ++it)
-                if (it->matches(ipv4Datagram))
-                    return it->gateIndex;
-            return -1;
+            fields.isIPv6 = false;
+            fields.srcAddr = ipv4Datagram->getSrcAddress();
+            fields.destAddr = ipv4Datagram->getDestAddress();
+            fields.protocol = ipv4Datagram->getTransportProtocol();
+            fields.tos = ipv4Datagram->getTypeOfService();
+            break;
         }
 #endif
 #ifdef WITH_IPv6
         IPv6Datagram *ipv6Datagram = dynamic_cast<IPv6Datagram *>(packet);
         if (ipv6Datagram)
         {
-            for (std::vector<Filter>::iterator it = filters.begin(); it != filters.end(); ++it)
-                if (it->matches(ipv6Datagram))
-                    return it->gateIndex;
-            return -1;
+            fields.isIPv6 = true;
+            fields.srcAddr = ipv6Datagram->getSrcAddress();
+            fields.destAddr = ipv6Datagram->getDestAddress();
+            fields.protocol = ipv6Datagram->getTransportProtocol();
+            fields.tos = ipv6Datagram->getTrafficClass();
+            break;
         }
 #endif
     }
+    if (!packet)
+        return false;
+
+    cPacket *transportPacket = packet->getEncapsulatedPacket();
+#ifdef WITH_UDP
+    UDPPacket *udpPacket = dynamic_cast<UDPPacket*>(transportPacket);
+    if (udpPacket)
+    {
+        fields.srcPort = udpPacket->getSourcePort();
+        fields.destPort = udpPacket->getDestinationPort();
+    }
+#endif
+#ifdef WITH_TCP_COMMON
+    TCPSegment *tcpSegment = dynamic_cast<TCPSegment*>(transportPacket);
+    if (tcpSegment)
+    {
+        fields.srcPort = tcpSegment->getSrcPort();
+        fields.destPort = tcpSegment->getDestPort();
+    }
+#endif
+    return true;
+}
+
+int MultiFieldClassifier::classifyPacket(cPacket *packet)
+{
+    PacketFields fields;
+    if (!extractFields(packet, fields))
+        return -1;
+
+    if (flowCacheSize > 0)
+    {
+        std::map<PacketFields, int>::iterator it = flowCache.find(fields);
+        bool hit = it != flowCache.end();
+        emit(flowCacheHitSignal, (long)hit);
+        if (hit)
+        {
+            numFlowCacheHits++;
+            emit(classificationCostSignal, 0L);
+            return it->second;
+        }
+        numFlowCacheMisses++;
+    }
+
+    int cost = 0;
+    int filterIndex = lookupFilters(fields, cost);
+    int gateIndex = filterIndex >= 0 ? filters[filterIndex].gateIndex : -1;
+    emit(classificationCostSignal, (long)cost);
+
+    if (flowCacheSize > 0)
+    {
+        // simple bounded cache: start over when full
+        if (flowCache.size() >= flowCacheSize)
+            flowCache.clear();
+        flowCache[fields] = gateIndex;
+    }
+    return gateIndex;
+}
+
+int MultiFieldClassifier::lookupFilters(const PacketFields& fields, int& cost)
+{
+    if (!compileFilters)
+    {
+        for (int i = 0; i < (int)filters.size(); i++)
+        {
+            cost++;
+            if (filters[i].matches(fields))
+                return i;
+        }
+        return -1;
+    }
 
-    return -1;
+    int bestIndex = -1;
+    for (std::vector<TupleSpaceEntry>::iterator it = tupleSpace.begin(); it != tupleSpace.end(); ++it)
+    {
+        // tuples are ordered by their first filter, no later tuple can do better
+        if (bestIndex >= 0 && it->minFilterIndex > bestIndex)
+            break;
+        if (!it->tuple.isApplicable(fields))
+            continue;
+        cost++;
+        std::map<PacketFields, std::vector<int> >::iterator jt = it->filterIndices.find(it->tuple.makeKey(fields));
+        if (jt == it->filterIndices.end())
+            continue;
+        const std::vector<int>& candidates = jt->second;
+        for (std::vector<int>::const_iterator kt = candidates.begin(); kt != candidates.end(); ++kt)
+        {
+            if (bestIndex >= 0 && *kt > bestIndex)
+                break;
+            cost++;
+            if (filters[*kt].matches(fields))
+            {
+                bestIndex = *kt;
+                break;
+            }
+        }
+    }
+    return bestIndex;
+}
+
+void MultiFieldClassifier::buildTupleSpace()
+{
+    // tuples are created in the order of their first filter,
+    // so tupleSpace ends up ordered by minFilterIndex
+    std::map<FilterTuple, int> tupleIndices;
+    tupleSpace.clear();
+    for (int i = 0; i < (int)filters.size(); i++)
+    {
+        const Filter& filter = filters[i];
+        FilterTuple tuple(filter);
+        std::map<FilterTuple, int>::iterator it = tupleIndices.find(tuple);
+        if (it == tupleIndices.end())
+        {
+            it = tupleIndices.insert(std::make_pair(tuple, (int)tupleSpace.size())).first;
+            tupleSpace.push_back(TupleSpaceEntry(tuple));
+            tupleSpace.back().minFilterIndex = i;
+        }
+        PacketFields key;
+        key.srcAddr = filter.srcAddr;
+        key.destAddr = filter.destAddr;
+        key.protocol = filter.protocol;
+        key.tos = filter.tos;
+        key.srcPort = filter.srcPortMin;
+        key.destPort = filter.destPortMin;
+        tupleSpace[it->second].filterIndices[tuple.makeKey(key)].push_back(i);
+    }
+    EV_DETAIL << "Compiled " << filters.size() << " filters into " << tupleSpace.size() << " tuples\n";
 }
 
 void MultiFieldClassifier::addFilter(const Filter &filter)
@@ -22,12 +22,40 @@
 
 #include "INETDefs.h"
 
+#include "FusedModuleBase.h"
+
+#include "IPvXAddress.h"
+
 /**
- * Absolute dropper.
+ * Multi-field classifier. See the NED file for details.
+ *
+ * Filters are compiled into a tuple space: filters that constrain the same
+ * set of header fields (prefix lengths, protocol, ToS mask, exact ports) share
+ * a tuple, and each tuple maps the masked field values to its filters.
+ * Classification probes one map per tuple instead of evaluating every filter,
+ * and the results of recent flows are kept in an exact-match flow cache.
  */
-class INET_API MultiFieldClassifier : public cSimpleModule
+class INET_API MultiFieldClassifier : public FusedModuleBase
 {
   protected:
+        /**
+         * Header fields of a datagram that filters can match on.
+         * Extracted once per packet.
+         */
+        struct PacketFields
+        {
+            bool isIPv6;
+            IPvXAddress srcAddr;
+            IPvXAddress destAddr;
+            int protocol;
+            int tos;
+            int srcPort;
+            int destPort;
+
+            PacketFields() : isIPv6(false), protocol(-1), tos(0), srcPort(-1), destPort(-1) {}
+            bool operator<(const PacketFields& other) const;
+        };
+
         struct Filter
         {
             int gateIndex;
@@ -47,25 +75,63 @@ class INET_API MultiFieldClassifier : public cSimpleModule
             Filter() : gateIndex(-1),
                        srcPrefixLength(0), destPrefixLength(0), protocol(-1), tos(0), tosMask(0),
                        srcPortMin(-1), srcPortMax(-1), destPortMin(-1), destPortMax(-1)  {}
-    #ifdef WITH_IPv4
-            bool matches(IPv4Datagram *datagram);
-    #endif
-    #ifdef WITH_IPv6
-            bool matches(IPv6Datagram *datagram);
-    #endif
+            bool matches(const PacketFields& fields) const;
+        };
+
+        /**
+         * The set of fields a filter constrains; filters with the same
+         * tuple share one lookup table (a std::map keyed by the masked fields)
+         * in the tuple space.
+         */
+        struct FilterTuple
+        {
+            int srcPrefixLength;
+            bool srcIPv6;
+            int destPrefixLength;
+            bool destIPv6;
+            bool hasProtocol;
+            int tosMask;
+            bool exactSrcPort;
+            bool exactDestPort;
+
+            explicit FilterTuple(const Filter& filter);
+            bool operator<(const FilterTuple& other) const;
+            bool isApplicable(const PacketFields& fields) const;
+            PacketFields makeKey(const PacketFields& fields) const;
+        };
+
+        struct TupleSpaceEntry
+        {
+            FilterTuple tuple;
+            int minFilterIndex;  // filters are tried in configuration order
+            std::map<PacketFields, std::vector<int> > filterIndices;
+
+            explicit TupleSpaceEntry(const FilterTuple& tuple) : tuple(tuple), minFilterIndex(-1) {}
         };
 
   protected:
     int numOutGates;
     std::vector<Filter> filters;
+    bool compileFilters;
+    std::vector<TupleSpaceEntry> tupleSpace;  // ordered by minFilterIndex
+
+    unsigned int flowCacheSize;
+    std::map<PacketFields, int> flowCache;  // fields -> gate index
 
     int numRcvd;
+    long numFlowCacheHits;
+    long numFlowCacheMisses;
 
     static simsignal_t pkClassSignal;
+    static simsignal_t classificationCostSignal;
+    static simsignal_t flowCacheHitSignal;
 
   protected:
     void addFilter(const Filter &filter);
     void configureFilters(cXMLElement *config);
+    void buildTupleSpace();
+    bool extractFields(cPacket *packet, PacketFields& fields);
+    int lookupFilters(const PacketFields& fields, int& cost);
 
   public:
     MultiFieldClassifier() {}
@@ -22,6 +22,8 @@
 
 #include "INETDefs.h"
 
+#include "FusedModuleBase.h"
+
 /**
  * This class can be used as a meter in an ITrafficConditioner.
  * It marks the packets according to three parameters,
@@ -30,7 +32,7 @@
  *
  * See RFC 2697.
  */
-class INET_API SingleRateThreeColorMeter : public cSimpleModule
+class INET_API SingleRateThreeColorMeter : public FusedModuleBase
 {
   protected:
     double CIR; // Commited Information Rate (bits/sec)
@@ -26,7 +26,7 @@ Define_Module(TokenBucketMeter);
 
 void TokenBucketMeter::initialize(int stage)
 {
-    cSimpleModule::initialize(stage);
+    FusedModuleBase::initialize(stage);
 
     if (stage == 0)
     {
@@ -57,12 +57,12 @@ void TokenBucketMeter::handleMessage(cMessage *msg)
     int color = meterPacket(packet);
     if (color == GREEN)
     {
-        send(packet, "greenOut");
+        sendFused(packet, "greenOut");
     }
     else
     {
         numRed++;
-        send(packet, "redOut");
+        sendFused(packet, "redOut");
     }
 
     if (ev.isGUI())
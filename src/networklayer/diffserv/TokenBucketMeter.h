@@ -22,10 +22,12 @@
 
 #include "INETDefs.h"
 
+#include "FusedModuleBase.h"
+
 /**
  * Simple token bucket meter.
  */
-class INET_API TokenBucketMeter : public cSimpleModule
+class INET_API TokenBucketMeter : public FusedModuleBase
 {
   protected:
     double CIR; // Commited Information Rate (bits/sec)
@@ -26,7 +26,7 @@ Define_Module(TwoRateThreeColorMeter);
 
 void TwoRateThreeColorMeter::initialize(int stage)
 {
-    cSimpleModule::initialize(stage);
+    FusedModuleBase::initialize(stage);
 
     if (stage == 0)
     {
@@ -61,9 +61,9 @@ void TwoRateThreeColorMeter::handleMessage(cMessage *msg)
     int color = meterPacket(packet);
     switch (color)
     {
-        case GREEN: send(packet, "greenOut"); break;
-        case YELLOW: numYellow++; send(packet, "yellowOut"); break;
-        case RED: numRed++; send(packet, "redOut"); break;
+        case GREEN: sendFused(packet, "greenOut"); break;
+        case YELLOW: numYellow++; sendFused(packet, "yellowOut"); break;
+        case RED: numRed++; sendFused(packet, "redOut"); break;
     }
 
     if (ev.isGUI())
@@ -22,6 +22,8 @@
 
 #include "INETDefs.h"
 
+#include "FusedModuleBase.h"
+
 /**
  * This class can be used as a meter in an ITrafficConditioner.
  * It marks the packets based on two rates, Peak Information Rate (PIR)
@@ -30,7 +32,7 @@
  *
  * See RFC 2698.
  */
-class INET_API TwoRateThreeColorMeter : public cSimpleModule
+class INET_API TwoRateThreeColorMeter : public FusedModuleBase
 {
   protected:
     double PIR; // Peak Information Rate (bits/sec)
@@ -332,7 +332,7 @@ IPv6NeighbourDiscovery::RDEntry *IPv6NeighbourDiscovery::fetchRDEntry(InterfaceE
 
 const MACAddress& IPv6NeighbourDiscovery::resolveNeighbour(const IPv6Address& nextHop, int interfaceId)
 {
-    Enter_Method("resolveNeighbor(%s,if=%d)", nextHop.str().c_str(), interfaceId);
+    Enter_Method_Lazy("resolveNeighbor(%s,if=%d)", nextHop.str().c_str(), interfaceId);
 
     Neighbour *nce = neighbourCache.lookup(nextHop, interfaceId);
     //InterfaceEntry *ie = ift->getInterfaceById(interfaceId);
@@ -364,7 +364,7 @@ const MACAddress& IPv6NeighbourDiscovery::resolveNeighbour(const IPv6Address& ne
 
 void IPv6NeighbourDiscovery::reachabilityConfirmed(const IPv6Address& neighbour, int interfaceId)
 {
-    Enter_Method("reachabilityConfirmed(%s,if=%d)", neighbour.str().c_str(), interfaceId);
+    Enter_Method_Lazy("reachabilityConfirmed(%s,if=%d)", neighbour.str().c_str(), interfaceId);
     //hmmm... this should only be invoked if a TCP ACK was received and NUD is
     //currently being performed on the neighbour where the TCP ACK was received from.
 
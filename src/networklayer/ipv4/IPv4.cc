@@ -69,7 +69,6 @@ void IPv4::initialize(int stage)
         useProxyARP = par("useProxyARP");
 
         curFragmentId = 0;
-        lastCheckTime = 0;
         fragbuf.init(icmpAccess.get());
 
         numMulticast = numLocalDeliver = numDropped = numUnroutable = numForwarded = 0;
@@ -106,6 +105,13 @@ void IPv4::updateDisplayString()
     getDisplayString().setTagArg("t", 0, buf);
 }
 
+void IPv4::finish()
+{
+    recordScalar("reassembled datagrams", fragbuf.getNumReassembled());
+    recordScalar("reassembly timeouts", fragbuf.getNumTimedOut());
+    recordScalar("max fragment bytes held", fragbuf.getMaxBytesHeld());
+}
+
 void IPv4::handleMessage(cMessage *msg)
 {
     if (msg->getKind() == IP_C_REGISTER_PROTOCOL) {
@@ -607,12 +613,8 @@ void IPv4::reassembleAndDeliver(IPv4Datagram *datagram)
         EV << "Datagram fragment: offset=" << datagram->getFragmentOffset()
            << ", MORE=" << (datagram->getMoreFragments() ? "true" : "false") << ".\n";
 
-        // erase timed out fragments in fragmentation buffer; check every 10 seconds max
-        if (simTime() >= lastCheckTime + 10)
-        {
-            lastCheckTime = simTime();
-            fragbuf.purgeStaleFragments(simTime()-fragmentTimeoutTime);
-        }
+        // erase timed out fragments in fragmentation buffer
+        fragbuf.purgeStaleFragments(simTime()-fragmentTimeoutTime);
 
         datagram = fragbuf.addFragment(datagram, simTime());
         if (!datagram)
@@ -85,7 +85,6 @@ class INET_API IPv4 : public QueueBase, public INetfilter, public ILifecycle, pu
     bool isUp;
     long curFragmentId; // counter, used to assign unique fragmentIds to datagrams
     IPv4FragBuf fragbuf;  // fragmentation reassembly buffer
-    simtime_t lastCheckTime; // when fragbuf was last checked for state fragments
     ProtocolMapping mapping; // where to send packets after decapsulation
 
     // ARP related
@@ -236,6 +235,7 @@ class INET_API IPv4 : public QueueBase, public INetfilter, public ILifecycle, pu
     virtual int numInitStages() const { return 2; }
     virtual void initialize(int stage);
     virtual void handleMessage(cMessage *msg);
+    virtual void finish();
 
     /**
      * Processing of IPv4 datagrams. Called when a datagram reaches the front
@@ -20,6 +20,7 @@
 #define _IPv4DATAGRAM_H_
 
 #include "INETDefs.h"
+#include "ObjectPool.h"
 #include "IPv4Datagram_m.h"
 
 /**
@@ -28,6 +29,8 @@
  */
 class INET_API IPv4Datagram : public IPv4Datagram_Base
 {
+    INET_POOLED_ALLOCATION(IPv4Datagram)
+
   public:
     IPv4Datagram(const char *name = NULL, int kind = 0) : IPv4Datagram_Base(name, kind) {}
     IPv4Datagram(const IPv4Datagram& other) : IPv4Datagram_Base(other) {}
@@ -32,13 +32,6 @@ IPv4FragBuf::IPv4FragBuf()
 
 IPv4FragBuf::~IPv4FragBuf()
 {
-    while (!bufs.empty())
-    {
-        if (bufs.begin()->second.datagram)
-            delete bufs.begin()->second.datagram;
-
-        bufs.erase(bufs.begin());
-    }
 }
 
 void IPv4FragBuf::init(ICMP *icmp)
@@ -54,20 +47,17 @@ IPv4Datagram *IPv4FragBuf::addFragment(IPv4Datagram *datagram, simtime_t now)
     key.src = datagram->getSrcAddress();
     key.dest = datagram->getDestAddress();
 
-    Buffers::iterator i = bufs.find(key);
+    Buffers::Buffer *buf = bufs.find(key);
 
-    DatagramBuffer *buf = NULL;
-
-    if (i == bufs.end())
+    if (buf == NULL)
     {
         // this is the first fragment of that datagram, create reassembly buffer for it
-        buf = &bufs[key];
-        buf->datagram = NULL;
+        buf = bufs.create(key, now);
     }
     else
     {
         // use existing buffer
-        buf = &(i->second);
+        bufs.touch(buf, now);
     }
 
     // add fragment into reassembly buffer
@@ -75,6 +65,7 @@ IPv4Datagram *IPv4FragBuf::addFragment(IPv4Datagram *datagram, simtime_t now)
     bool isComplete = buf->buf.addFragment(datagram->getFragmentOffset(),
                                            datagram->getFragmentOffset() + bytes,
                                            !datagram->getMoreFragments());
+    bufs.addBytes(buf, bytes);
 
     // store datagram. Only one fragment carries the actual modelled
     // content (getEncapsulatedPacket()), other (empty) ones are only
@@ -97,49 +88,35 @@ IPv4Datagram *IPv4FragBuf::addFragment(IPv4Datagram *datagram, simtime_t now)
     if (isComplete)
     {
         // datagram complete: deallocate buffer and return complete datagram
-        IPv4Datagram *ret = buf->datagram;
-        ret->setByteLength(ret->getHeaderLength()+buf->buf.getTotalLength());
+        ushort totalLength = buf->buf.getTotalLength();
+        IPv4Datagram *ret = bufs.remove(buf, false);
+        ret->setByteLength(ret->getHeaderLength()+totalLength);
         ret->setFragmentOffset(0);
         ret->setMoreFragments(false);
-        bufs.erase(i);
         return ret;
     }
     else
     {
         // there are still missing fragments
-        buf->lastupdate = now;
         return NULL;
     }
 }
 
 void IPv4FragBuf::purgeStaleFragments(simtime_t lastupdate)
 {
-    // this method shouldn't be called too often because iteration on
-    // an std::map is *very* slow...
-
-    ASSERT(icmpModule);
-
-    for (Buffers::iterator i = bufs.begin(); i != bufs.end(); )
+    // buffers are ordered by their last update, so the stale ones are at the head
+    Buffers::Buffer *buf;
+    while ((buf = bufs.getOldest()) != NULL && buf->timestamp < lastupdate)
     {
-        // if too old, remove it
-        DatagramBuffer& buf = i->second;
-        if (buf.lastupdate < lastupdate)
-        {
-            // send ICMP error.
-            // Note: receiver MUST NOT call decapsulate() on the datagram fragment,
-            // because its length (being a fragment) is smaller than the encapsulated
-            // packet, resulting in "length became negative" error. Use getEncapsulatedPacket().
-            EV << "datagram fragment timed out in reassembly buffer, sending ICMP_TIME_EXCEEDED\n";
-            icmpModule->sendErrorMessage(buf.datagram, -1 /*TODO*/, ICMP_TIME_EXCEEDED, 0);
-
-            // delete
-            Buffers::iterator oldi = i++;
-            bufs.erase(oldi);
-        }
-        else
-        {
-            ++i;
-        }
+        ASSERT(icmpModule);
+
+        // send ICMP error.
+        // Note: receiver MUST NOT call decapsulate() on the datagram fragment,
+        // because its length (being a fragment) is smaller than the encapsulated
+        // packet, resulting in "length became negative" error. Use getEncapsulatedPacket().
+        EV << "datagram fragment timed out in reassembly buffer, sending ICMP_TIME_EXCEEDED\n";
+        IPv4Datagram *datagram = bufs.remove(buf, true);
+        icmpModule->sendErrorMessage(datagram, -1 /*TODO*/, ICMP_TIME_EXCEEDED, 0);
     }
 }
 
@@ -19,12 +19,10 @@
 #define __INET_IPv4FRAGBUF_H
 
 
-#include <map>
-
 #include "INETDefs.h"
 
 #include "IPv4Address.h"
-#include "ReassemblyBuffer.h"
+#include "ReassemblyBufferTable.h"
 
 
 class ICMP;
@@ -51,20 +49,8 @@ class INET_API IPv4FragBuf
         }
     };
 
-    //
-    // Reassembly buffer for the datagram
-    //
-    struct DatagramBuffer
-    {
-        ReassemblyBuffer buf;  // reassembly buffer
-        IPv4Datagram *datagram;  // the actual datagram
-        simtime_t lastupdate;  // last time a new fragment arrived
-    };
-
-    // we use std::map for fast lookup by datagram Id
-    typedef std::map<Key,DatagramBuffer> Buffers;
-
-    // the reassembly buffers
+    // the reassembly buffers, in the order of their last update (last fragment arrival)
+    typedef ReassemblyBufferTable<Key,IPv4Datagram> Buffers;
     Buffers bufs;
 
     // needed for TIME_EXCEEDED errors
@@ -100,10 +86,19 @@ class INET_API IPv4FragBuf
      * and sends ICMP TIME EXCEEDED message about them.
      *
      * Timeout should be between 60 seconds and 120 seconds (RFC1122).
-     * This method should be called more frequently, maybe every
-     * 10..30 seconds or so.
+     * The cost is proportional to the number of buffers thrown out,
+     * so this method may be called for every arriving fragment.
      */
     void purgeStaleFragments(simtime_t lastupdate);
+
+    /** @name Statistics */
+    //@{
+    int getNumBuffers() const {return bufs.getNumBuffers();}
+    long getBytesHeld() const {return bufs.getBytesHeld();}
+    long getMaxBytesHeld() const {return bufs.getMaxBytesHeld();}
+    long getNumReassembled() const {return bufs.getNumReassembled();}
+    long getNumTimedOut() const {return bufs.getNumTimedOut();}
+    //@}
 };
 
 #endif
@@ -357,7 +357,7 @@ void RoutingTable::configureInterfaceForIPv4(InterfaceEntry *ie)
 
 InterfaceEntry *RoutingTable::getInterfaceByAddress(const IPv4Address& addr) const
 {
-    Enter_Method("getInterfaceByAddress(%u.%u.%u.%u)", addr.getDByte(0), addr.getDByte(1), addr.getDByte(2), addr.getDByte(3)); // note: str().c_str() too slow here
+    Enter_Method_Lazy("getInterfaceByAddress(%u.%u.%u.%u)", addr.getDByte(0), addr.getDByte(1), addr.getDByte(2), addr.getDByte(3));
 
     if (addr.isUnspecified())
         return NULL;
@@ -389,7 +389,7 @@ void RoutingTable::configureLoopbackForIPv4()
 
 bool RoutingTable::isLocalAddress(const IPv4Address& dest) const
 {
-    Enter_Method("isLocalAddress(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3)); // note: str().c_str() too slow here
+    Enter_Method_Lazy("isLocalAddress(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3));
 
     if (localAddresses.empty())
     {
@@ -408,7 +408,7 @@ bool RoutingTable::isLocalAddress(const IPv4Address& dest) const
 // JcM add: check if the dest addr is local network broadcast
 bool RoutingTable::isLocalBroadcastAddress(const IPv4Address& dest) const
 {
-    Enter_Method("isLocalBroadcastAddress(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3)); // note: str().c_str() too slow here
+    Enter_Method_Lazy("isLocalBroadcastAddress(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3));
 
     if (localBroadcastAddresses.empty())
     {
@@ -443,7 +443,7 @@ InterfaceEntry *RoutingTable::findInterfaceByLocalBroadcastAddress(const IPv4Add
 
 bool RoutingTable::isLocalMulticastAddress(const IPv4Address& dest) const
 {
-    Enter_Method("isLocalMulticastAddress(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3)); // note: str().c_str() too slow here
+    Enter_Method_Lazy("isLocalMulticastAddress(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3));
 
     for (int i=0; i<ift->getNumInterfaces(); i++)
     {
@@ -499,7 +499,7 @@ void RoutingTable::purge()
 
 IPv4Route *RoutingTable::findBestMatchingRoute(const IPv4Address& dest) const
 {
-    Enter_Method("findBestMatchingRoute(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3)); // note: str().c_str() too slow here
+    Enter_Method_Lazy("findBestMatchingRoute(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3));
 
     RoutingCache::iterator it = routingCache.find(dest);
     if (it != routingCache.end())
@@ -530,7 +530,7 @@ IPv4Route *RoutingTable::findBestMatchingRoute(const IPv4Address& dest) const
 
 InterfaceEntry *RoutingTable::getInterfaceForDestAddr(const IPv4Address& dest) const
 {
-    Enter_Method("getInterfaceForDestAddr(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3)); // note: str().c_str() too slow here
+    Enter_Method_Lazy("getInterfaceForDestAddr(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3));
 
     const IPv4Route *e = findBestMatchingRoute(dest);
     return e ? e->getInterface() : NULL;
@@ -538,7 +538,7 @@ InterfaceEntry *RoutingTable::getInterfaceForDestAddr(const IPv4Address& dest) c
 
 IPv4Address RoutingTable::getGatewayForDestAddr(const IPv4Address& dest) const
 {
-    Enter_Method("getGatewayForDestAddr(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3)); // note: str().c_str() too slow here
+    Enter_Method_Lazy("getGatewayForDestAddr(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3));
 
     const IPv4Route *e = findBestMatchingRoute(dest);
     return e ? e->getGateway() : IPv4Address();
@@ -547,9 +547,9 @@ IPv4Address RoutingTable::getGatewayForDestAddr(const IPv4Address& dest) const
 
 const IPv4MulticastRoute *RoutingTable::findBestMatchingMulticastRoute(const IPv4Address &origin, const IPv4Address &group) const
 {
-    Enter_Method("getMulticastRoutesFor(%u.%u.%u.%u, %u.%u.%u.%u)",
+    Enter_Method_Lazy("getMulticastRoutesFor(%u.%u.%u.%u, %u.%u.%u.%u)",
             origin.getDByte(0), origin.getDByte(1), origin.getDByte(2), origin.getDByte(3),
-            group.getDByte(0), group.getDByte(1), group.getDByte(2), group.getDByte(3)); // note: str().c_str() too slow here here
+            group.getDByte(0), group.getDByte(1), group.getDByte(2), group.getDByte(3));
 
     // TODO caching?
 
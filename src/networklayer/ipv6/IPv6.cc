@@ -63,7 +63,6 @@ void IPv6::initialize(int stage)
         tunneling = IPv6TunnelingAccess().get();
 
         curFragmentId = 0;
-        lastCheckTime = SIMTIME_ZERO;
         fragbuf.init(icmp);
 
         numMulticast = numLocalDeliver = numDropped = numUnroutable = numForwarded = 0;
@@ -95,6 +94,13 @@ void IPv6::updateDisplayString()
     getDisplayString().setTagArg("t", 0, buf);
 }
 
+void IPv6::finish()
+{
+    recordScalar("reassembled datagrams", fragbuf.getNumReassembled());
+    recordScalar("reassembly timeouts", fragbuf.getNumTimedOut());
+    recordScalar("max fragment bytes held", fragbuf.getMaxBytesHeld());
+}
+
 void IPv6::handleMessage(cMessage *msg)
 {
     if (msg->getKind() == IP_C_REGISTER_PROTOCOL)
@@ -506,12 +512,8 @@ void IPv6::localDeliver(IPv6Datagram *datagram)
         EV << "Datagram fragment: offset=" << fh->getFragmentOffset()
            << ", MORE=" << (fh->getMoreFragments() ? "true" : "false") << ".\n";
 
-        // erase timed out fragments in fragmentation buffer; check every 10 seconds max
-        if (simTime() >= lastCheckTime + 10)
-        {
-            lastCheckTime = simTime();
-            fragbuf.purgeStaleFragments(simTime()-FRAGMENT_TIMEOUT);
-        }
+        // erase timed out fragments in fragmentation buffer
+        fragbuf.purgeStaleFragments(simTime()-FRAGMENT_TIMEOUT);
 
         datagram = fragbuf.addFragment(datagram, fh, simTime());
         if (!datagram)
@@ -50,7 +50,6 @@ class INET_API IPv6 : public QueueBase, public ILifecycle
     // working vars
     unsigned int curFragmentId; // counter, used to assign unique fragmentIds to datagrams
     IPv6FragBuf fragbuf;  // fragmentation reassembly buffer
-    simtime_t lastCheckTime; // when fragbuf was last checked for state fragments
     ProtocolMapping mapping; // where to send packets after decapsulation
 
     // statistics
@@ -146,6 +145,11 @@ class INET_API IPv6 : public QueueBase, public ILifecycle
      */
     virtual void handleMessage(cMessage *msg);
 
+    /**
+     * Records reassembly statistics
+     */
+    virtual void finish();
+
     /**
      * Processing of IPv6 datagrams. Called when a datagram reaches the front
      * of the queue.
@@ -50,22 +50,6 @@ IPv6Datagram *IPv6FragBuf::addFragment(IPv6Datagram *datagram, IPv6FragmentHeade
     key.src = datagram->getSrcAddress();
     key.dest = datagram->getDestAddress();
 
-    Buffers::iterator i = bufs.find(key);
-
-    DatagramBuffer *buf = NULL;
-    if (i==bufs.end())
-    {
-        // this is the first fragment of that datagram, create reassembly buffer for it
-        buf = &bufs[key];
-        buf->datagram = NULL;
-        buf->createdAt = now;
-    }
-    else
-    {
-        // use existing buffer
-        buf = &(i->second);
-    }
-
     int fragmentLength = datagram->calculateFragmentLength();
     unsigned short offset = fh->getFragmentOffset();
     bool moreFragments = fh->getMoreFragments();
@@ -96,7 +80,15 @@ IPv6Datagram *IPv6FragBuf::addFragment(IPv6Datagram *datagram, IPv6FragmentHeade
         return NULL;
     }
 
+    Buffers::Buffer *buf = bufs.find(key);
+    if (buf == NULL)
+    {
+        // this is the first fragment of that datagram, create reassembly buffer for it
+        buf = bufs.create(key, now);
+    }
+
     // add fragment to buffer
+    bufs.addBytes(buf, fragmentLength);
     bool isComplete = buf->buf.addFragment(offset,
                                            offset+fragmentLength,
                                            !moreFragments);
@@ -118,11 +110,11 @@ IPv6Datagram *IPv6FragBuf::addFragment(IPv6Datagram *datagram, IPv6FragmentHeade
     if (isComplete)
     {
         // datagram complete: deallocate buffer and return complete datagram
-        IPv6Datagram *ret = buf->datagram;
+        ushort totalLength = buf->buf.getTotalLength();
+        IPv6Datagram *ret = bufs.remove(buf, false);
         ASSERT(ret);
         ret->removeExtensionHeader(IP_PROT_IPv6EXT_FRAGMENT);
-        ret->setByteLength(ret->calculateUnfragmentableHeaderByteLength()+buf->buf.getTotalLength());
-        bufs.erase(i);
+        ret->setByteLength(ret->calculateUnfragmentableHeaderByteLength()+totalLength);
         return ret;
     }
     else
@@ -145,31 +137,18 @@ IPv6Datagram *IPv6FragBuf::addFragment(IPv6Datagram *datagram, IPv6FragmentHeade
  */
 void IPv6FragBuf::purgeStaleFragments(simtime_t lastupdate)
 {
-    // this method shouldn't be called too often because iteration on
-    // an std::map is *very* slow...
-
-    ASSERT(icmpModule);
-
-    for (Buffers::iterator i=bufs.begin(); i!=bufs.end(); )
+    // buffers are ordered by their creation time, so the stale ones are at the head
+    Buffers::Buffer *buf;
+    while ((buf = bufs.getOldest()) != NULL && buf->timestamp < lastupdate)
     {
-        // if too old, remove it
-        DatagramBuffer& buf = i->second;
-        if (buf.createdAt < lastupdate)
-        {
-            if (buf.datagram)
-            {
-                // send ICMP error
-                EV << "datagram fragment timed out in reassembly buffer, sending ICMP_TIME_EXCEEDED\n";
-                icmpModule->sendErrorMessage(buf.datagram, ICMPv6_TIME_EXCEEDED, 0);
-            }
-
-            // delete
-            Buffers::iterator oldi = i++;
-            bufs.erase(oldi);
-        }
-        else
+        ASSERT(icmpModule);
+
+        IPv6Datagram *datagram = bufs.remove(buf, true);
+        if (datagram)
         {
-            ++i;
+            // send ICMP error
+            EV << "datagram fragment timed out in reassembly buffer, sending ICMP_TIME_EXCEEDED\n";
+            icmpModule->sendErrorMessage(datagram, ICMPv6_TIME_EXCEEDED, 0);
         }
     }
 }
@@ -18,10 +18,8 @@
 #ifndef __IPv6FRAGBUF_H__
 #define __IPv6FRAGBUF_H__
 
-#include <map>
-#include <vector>
 #include "INETDefs.h"
-#include "ReassemblyBuffer.h"
+#include "ReassemblyBufferTable.h"
 #include "IPv6Address.h"
 
 class ICMPv6;
@@ -48,20 +46,10 @@ class INET_API IPv6FragBuf
         }
     };
 
-    //
-    // Reassembly buffer for the datagram
-    //
-    struct DatagramBuffer
-    {
-        ReassemblyBuffer buf;  // reassembly buffer
-        IPv6Datagram *datagram;  // the actual datagram
-        simtime_t createdAt;  // time of the buffer creation (i.e. reception time of first-arriving fragment)
-    };
-
-    // we use std::map for fast lookup by datagram Id
-    typedef std::map<Key,DatagramBuffer> Buffers;
-
-    // the reassembly buffers
+    // the reassembly buffers, in the order of their creation (i.e. reception
+    // time of the first-arriving fragment); buffers only hold a datagram
+    // once the first fragment (offset 0) has arrived
+    typedef ReassemblyBufferTable<Key,IPv6Datagram> Buffers;
     Buffers bufs;
 
     // needed for TIME_EXCEEDED errors
@@ -97,10 +85,19 @@ class INET_API IPv6FragBuf
      * and sends ICMP TIME EXCEEDED message about them.
      *
      * Timeout should be between 60 seconds and 120 seconds (RFC1122).
-     * This method should be called more frequently, maybe every
-     * 10..30 seconds or so.
+     * The cost is proportional to the number of buffers thrown out,
+     * so this method may be called for every arriving fragment.
      */
     void purgeStaleFragments(simtime_t lastupdate);
+
+    /** @name Statistics */
+    //@{
+    int getNumBuffers() const {return bufs.getNumBuffers();}
+    long getBytesHeld() const {return bufs.getBytesHeld();}
+    long getMaxBytesHeld() const {return bufs.getMaxBytesHeld();}
+    long getNumReassembled() const {return bufs.getNumReassembled();}
+    long getNumTimedOut() const {return bufs.getNumTimedOut();}
+    //@}
 };
 
 #endif
@@ -0,0 +1,96 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "JitteredSendScheduler.h"
+
+
+JitteredSendScheduler::JitteredSendScheduler(cSimpleModule *owner, const char *gateName, simtime_t coalescingWindow, const char *timerName)
+{
+    if (coalescingWindow < SIMTIME_ZERO)
+        throw cRuntimeError("JitteredSendScheduler: coalescing window must not be negative");
+    this->owner = owner;
+    this->gateName = gateName;
+    this->coalescingWindow = coalescingWindow;
+    timer = new cMessage(timerName);
+    numSent = numBatches = 0;
+}
+
+JitteredSendScheduler::~JitteredSendScheduler()
+{
+    clear();
+    owner->cancelAndDelete(timer);
+}
+
+void JitteredSendScheduler::scheduleTimer()
+{
+    if (packets.empty())
+    {
+        if (timer->isScheduled())
+            owner->cancelEvent(timer);
+        return;
+    }
+    simtime_t sendTime = packets.begin()->first;
+    if (timer->isScheduled())
+    {
+        if (timer->getArrivalTime() == sendTime)
+            return;
+        owner->cancelEvent(timer);
+    }
+    owner->scheduleAt(sendTime, timer);
+}
+
+void JitteredSendScheduler::sendDelayed(cPacket *packet, simtime_t delay)
+{
+    numSent++;
+    if (delay == SIMTIME_ZERO)
+        owner->send(packet, gateName.c_str());
+    else if (coalescingWindow == SIMTIME_ZERO)
+    {
+        numBatches++;
+        owner->sendDelayed(packet, delay, gateName.c_str());
+    }
+    else
+    {
+        // packets due within the window after the earliest one go out with it, see handleTimer()
+        packets.insert(std::pair<simtime_t, cPacket *>(simTime() + delay, packet));
+        scheduleTimer();
+    }
+}
+
+void JitteredSendScheduler::handleTimer(cMessage *msg)
+{
+    ASSERT(msg == timer);
+    numBatches++;
+    simtime_t limit = simTime() + coalescingWindow;
+    while (!packets.empty() && packets.begin()->first <= limit)
+    {
+        cPacket *packet = packets.begin()->second;
+        packets.erase(packets.begin());
+        owner->send(packet, gateName.c_str());
+    }
+    scheduleTimer();
+}
+
+void JitteredSendScheduler::clear()
+{
+    for (PacketMap::iterator it = packets.begin(); it != packets.end(); ++it)
+        delete it->second;
+    packets.clear();
+    if (timer->isScheduled())
+        owner->cancelEvent(timer);
+}
@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __INET_JITTEREDSENDSCHEDULER_H
+#define __INET_JITTEREDSENDSCHEDULER_H
+
+#include <map>
+#include <string>
+#include "INETDefs.h"
+
+
+/**
+ * Sends the jittered control packets of a MANET routing protocol
+ * (RFC 5148 forwarding and broadcast jitter) through one output gate of
+ * the owner module.
+ *
+ * With a zero coalescing window (the default) every packet is simply sent
+ * with sendDelayed(), exactly as the protocols did before. With a positive
+ * window the packets are kept here, and a single timer is scheduled for the
+ * earliest one; when the timer fires, every packet due within the window
+ * is sent at once. In route discovery storms, where every node forwards
+ * many RREQs with independent jitter, this replaces one future event per
+ * packet with one per batch, at the cost of sending some packets up to
+ * one window earlier than their jitter would dictate.
+ *
+ * The owner module must recognize the timer with isTimer(), and pass it
+ * to handleTimer().
+ *
+ * Used by AODVRouting and xDYMO.
+ */
+class INET_API JitteredSendScheduler
+{
+  protected:
+    typedef std::multimap<simtime_t, cPacket *> PacketMap;
+
+    cSimpleModule *owner;
+    std::string gateName;
+    simtime_t coalescingWindow;
+    cMessage *timer;
+    PacketMap packets;
+
+    // statistics
+    long numSent;
+    long numBatches;
+
+  protected:
+    void scheduleTimer();
+
+  public:
+    /**
+     * Creates a scheduler that sends packets through the given gate of the
+     * owner module.
+     */
+    JitteredSendScheduler(cSimpleModule *owner, const char *gateName, simtime_t coalescingWindow = SIMTIME_ZERO, const char *timerName = "jitteredSendTimer");
+
+    /**
+     * Cancels and deletes the timer, and deletes the packets not yet sent.
+     */
+    virtual ~JitteredSendScheduler();
+
+    /**
+     * Sends the packet after the given delay, or within the coalescing
+     * window before that.
+     */
+    virtual void sendDelayed(cPacket *packet, simtime_t delay);
+
+    /**
+     * Returns true if msg is the timer of this scheduler.
+     */
+    bool isTimer(cMessage *msg) const { return msg == timer; }
+
+    /**
+     * Sends the packets that are due; to be called when the timer arrives.
+     */
+    virtual void handleTimer(cMessage *msg);
+
+    /**
+     * Deletes the packets not yet sent and cancels the timer.
+     */
+    virtual void clear();
+
+    /** @name Statistics */
+    //@{
+    int getNumPending() const { return packets.size(); }
+    long getNumSent() const { return numSent; }
+    long getNumBatches() const { return numBatches; }
+    //@}
+};
+
+#endif
@@ -28,6 +28,9 @@
 
 Define_Module(AODVRouting);
 
+simsignal_t AODVRouting::dropPkBufferOverflowSignal = registerSignal("dropPkBufferOverflow");
+simsignal_t AODVRouting::dropPkNoRouteSignal = registerSignal("dropPkNoRoute");
+
 void AODVRouting::initialize(int stage)
 {
     if (stage == 0) {
@@ -65,6 +68,10 @@ void AODVRouting::initialize(int stage)
         netTraversalTime = par("netTraversalTime");
         nextHopWait = par("nextHopWait");
         pathDiscoveryTime = par("pathDiscoveryTime");
+        bufferSizePackets = par("bufferSizePackets");
+        if (bufferSizePackets == 0 || bufferSizePackets < -1)
+            throw cRuntimeError("Invalid bufferSizePackets=%d, must be positive or -1", bufferSizePackets);
+        sendScheduler = new JitteredSendScheduler(this, "ipOut", par("jitterCoalescingWindow"), "AODVJitteredSendTimer");
     }
     else if (stage == 4) {
         NodeStatus *nodeStatus = dynamic_cast<NodeStatus *>(host->getSubmodule("status"));
@@ -97,6 +104,12 @@ void AODVRouting::initialize(int stage)
     }
 }
 
+void AODVRouting::finish()
+{
+    recordScalar("jittered packets sent", sendScheduler->getNumSent());
+    recordScalar("jittered send batches", sendScheduler->getNumBatches());
+}
+
 void AODVRouting::handleMessage(cMessage *msg)
 {
     if (!isOperational) {
@@ -108,7 +121,9 @@ void AODVRouting::handleMessage(cMessage *msg)
     }
 
     if (msg->isSelfMessage()) {
-        if (dynamic_cast<WaitForRREP *>(msg))
+        if (sendScheduler->isTimer(msg))
+            sendScheduler->handleTimer(msg);
+        else if (dynamic_cast<WaitForRREP *>(msg))
             handleWaitForRREP((WaitForRREP *)msg);
         else if (msg == helloMsgTimer)
             sendHelloMessagesIfNeeded();
@@ -226,6 +241,7 @@ AODVRouting::AODVRouting()
     rrepAckTimer = NULL;
     jitterPar = NULL;
     nb = NULL;
+    sendScheduler = NULL;
 }
 
 bool AODVRouting::hasOngoingRouteDiscovery(const IPv4Address& target)
@@ -251,9 +267,24 @@ void AODVRouting::delayDatagram(IPv4Datagram *datagram)
 {
     EV_DETAIL << "Queuing datagram, source " << datagram->getSrcAddress() << ", destination " << datagram->getDestAddress() << endl;
     const IPv4Address& target = datagram->getDestAddress();
+
+    // the oldest datagram is dropped if the buffer of the destination is full
+    if (bufferSizePackets > 0 && (int)targetAddressToDelayedPackets.count(target) >= bufferSizePackets) {
+        std::multimap<IPv4Address, IPv4Datagram *>::iterator oldest = targetAddressToDelayedPackets.lower_bound(target);
+        IPv4Datagram *oldestDatagram = oldest->second;
+        targetAddressToDelayedPackets.erase(oldest);
+        dropDelayedDatagram(oldestDatagram, dropPkBufferOverflowSignal);
+    }
     targetAddressToDelayedPackets.insert(std::pair<IPv4Address, IPv4Datagram *>(target, datagram));
 }
 
+void AODVRouting::dropDelayedDatagram(IPv4Datagram *datagram, simsignal_t signal)
+{
+    EV_DETAIL << "Dropping queued datagram, source " << datagram->getSrcAddress() << ", destination " << datagram->getDestAddress() << endl;
+    emit(signal, datagram);
+    networkProtocol->dropQueuedDatagram(const_cast<const IPv4Datagram *>(datagram));
+}
+
 void AODVRouting::sendRREQ(AODVRREQ *rreq, const IPv4Address& destAddr, unsigned int timeToLive)
 {
     // In an expanding ring search, the originating node initially uses a TTL =
@@ -411,7 +442,7 @@ AODVRREQ *AODVRouting::createRREQ(const IPv4Address& destAddr)
     // it will not reprocess and re-forward the packet.
 
     RREQIdentifier rreqIdentifier(getSelfIPAddress(), rreqId);
-    rreqsArrivalTime[rreqIdentifier] = simTime();
+    addRREQIdentifier(rreqIdentifier);
 
     return rreqPacket;
 }
@@ -733,10 +764,7 @@ void AODVRouting::sendAODVPacket(AODVControlPacket *packet, const IPv4Address& d
     if (destAddr.isLimitedBroadcastAddress())
         lastBroadcastTime = simTime();
 
-    if (delay == 0)
-        send(udpPacket, "ipOut");
-    else
-        sendDelayed(udpPacket, delay, "ipOut");
+    sendScheduler->sendDelayed(udpPacket, delay);
 }
 
 void AODVRouting::handleRREQ(AODVRREQ *rreq, const IPv4Address& sourceAddr, unsigned int timeToLive)
@@ -770,15 +798,13 @@ void AODVRouting::handleRREQ(AODVRREQ *rreq, const IPv4Address& sourceAddr, unsi
     // If such a RREQ has been received, the node silently discards the newly received RREQ.
 
     RREQIdentifier rreqIdentifier(rreq->getOriginatorAddr(), rreq->getRreqId());
-    std::map<RREQIdentifier, simtime_t, RREQIdentifierCompare>::iterator checkRREQArrivalTime = rreqsArrivalTime.find(rreqIdentifier);
-    if (checkRREQArrivalTime != rreqsArrivalTime.end() && simTime() - checkRREQArrivalTime->second <= pathDiscoveryTime) {
+    if (isDuplicateRREQ(rreqIdentifier)) {
         EV_WARN << "The same packet has arrived within PATH_DISCOVERY_TIME= " << pathDiscoveryTime << ". Discarding it" << endl;
         delete rreq;
         return;
     }
 
-    // update or create
-    rreqsArrivalTime[rreqIdentifier] = simTime();
+    addRREQIdentifier(rreqIdentifier);
 
     // First, it first increments the hop count value in the RREQ by one, to
     // account for the new hop through the intermediate node.
@@ -1222,6 +1248,10 @@ void AODVRouting::clearState()
 
     waitForRREPTimers.clear();
     rreqsArrivalTime.clear();
+    rreqArrivalQueue.clear();
+
+    if (sendScheduler)
+        sendScheduler->clear();
 
     if (useHelloMessages)
         cancelEvent(helloMsgTimer);
@@ -1568,7 +1598,7 @@ void AODVRouting::cancelRouteDiscovery(const IPv4Address& destAddr)
     std::multimap<IPv4Address, IPv4Datagram *>::iterator lt = targetAddressToDelayedPackets.lower_bound(destAddr);
     std::multimap<IPv4Address, IPv4Datagram *>::iterator ut = targetAddressToDelayedPackets.upper_bound(destAddr);
     for (std::multimap<IPv4Address, IPv4Datagram *>::iterator it = lt; it != ut; it++)
-        networkProtocol->dropQueuedDatagram(const_cast<const IPv4Datagram *>(it->second));
+        dropDelayedDatagram(it->second, dropPkNoRouteSignal);
 
     targetAddressToDelayedPackets.erase(lt, ut);
 }
@@ -1652,9 +1682,42 @@ void AODVRouting::handleBlackListTimer()
         scheduleAt(nextTime, blacklistTimer);
 }
 
+bool AODVRouting::isDuplicateRREQ(const RREQIdentifier& rreqIdentifier)
+{
+    expungeRREQIdentifiers();
+    return rreqsArrivalTime.find(rreqIdentifier) != rreqsArrivalTime.end();
+}
+
+void AODVRouting::addRREQIdentifier(const RREQIdentifier& rreqIdentifier)
+{
+    expungeRREQIdentifiers();
+    std::pair<std::map<RREQIdentifier, simtime_t, RREQIdentifierCompare>::iterator, bool> result =
+        rreqsArrivalTime.insert(std::make_pair(rreqIdentifier, simTime()));
+    if (!result.second)
+        result.first->second = simTime();
+    rreqArrivalQueue.push_back(std::make_pair(simTime(), rreqIdentifier));
+}
+
+void AODVRouting::expungeRREQIdentifiers()
+{
+    // All entries have the same lifetime (PATH_DISCOVERY_TIME), so the queue
+    // is ordered by expiry as well, and expired entries are only ever at its
+    // front. A refreshed identifier has a newer entry further back in the
+    // queue; its old entry must not remove it from the map.
+    simtime_t now = simTime();
+    while (!rreqArrivalQueue.empty() && now - rreqArrivalQueue.front().first > pathDiscoveryTime) {
+        const std::pair<simtime_t, RREQIdentifier>& entry = rreqArrivalQueue.front();
+        std::map<RREQIdentifier, simtime_t, RREQIdentifierCompare>::iterator it = rreqsArrivalTime.find(entry.second);
+        if (it != rreqsArrivalTime.end() && it->second == entry.first)
+            rreqsArrivalTime.erase(it);
+        rreqArrivalQueue.pop_front();
+    }
+}
+
 AODVRouting::~AODVRouting()
 {
     clearState();
+    delete sendScheduler;
     delete helloMsgTimer;
     delete expungeTimer;
     delete counterTimer;
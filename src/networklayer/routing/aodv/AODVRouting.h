@@ -28,10 +28,12 @@
 #include "NodeStatus.h"
 #include "NotificationBoard.h"
 #include "UDPSocket.h"
+#include "JitteredSendScheduler.h"
 #include "AODVRouteData.h"
 #include "UDPPacket.h"
 #include "AODVControlPackets_m.h"
 #include <map>
+#include <deque>
 
 /*
  * This class implements AODV routing protocol and Netfilter hooks
@@ -62,7 +64,9 @@ class INET_API AODVRouting : public cSimpleModule, public ILifecycle, public INe
       public:
         bool operator()(const RREQIdentifier& lhs, const RREQIdentifier& rhs) const
         {
-            return lhs.rreqID < rhs.rreqID;
+            if (lhs.rreqID != rhs.rreqID)
+                return lhs.rreqID < rhs.rreqID;
+            return lhs.originatorAddr < rhs.originatorAddr;
         }
     };
 
@@ -111,6 +115,7 @@ class INET_API AODVRouting : public cSimpleModule, public ILifecycle, public INe
     unsigned int sequenceNum;    // it helps to prevent loops in the routes (RFC 3561 6.1 p11.)
     std::map<IPv4Address, WaitForRREP *> waitForRREPTimers;    // timeout for Route Replies
     std::map<RREQIdentifier, simtime_t, RREQIdentifierCompare> rreqsArrivalTime;    // maps RREQ id to its arriving time
+    std::deque<std::pair<simtime_t, RREQIdentifier> > rreqArrivalQueue;    // rreqsArrivalTime entries in arrival order, for expiry
     IPv4Address failedNextHop;    // next hop to the destination who failed to send us RREP-ACK
     std::map<IPv4Address, simtime_t> blacklist;    // we don't accept RREQs from blacklisted nodes
     unsigned int rerrCount;    // num of originated RERR in the last second
@@ -131,11 +136,17 @@ class INET_API AODVRouting : public cSimpleModule, public ILifecycle, public INe
 
     // internal
     std::multimap<IPv4Address, IPv4Datagram *> targetAddressToDelayedPackets;    // queue for the datagrams we have no route for
+    int bufferSizePackets;    // max number of delayed datagrams per destination, -1 means unlimited
+    JitteredSendScheduler *sendScheduler;    // sends the jittered control packets
+
+    static simsignal_t dropPkBufferOverflowSignal;
+    static simsignal_t dropPkNoRouteSignal;
 
   protected:
     void handleMessage(cMessage *msg);
     void initialize(int stage);
     virtual int numInitStages() const { return 5; }
+    virtual void finish();
 
     /* Route Discovery */
     void startRouteDiscovery(const IPv4Address& target, unsigned int timeToLive = 0);
@@ -194,6 +205,12 @@ class INET_API AODVRouting : public cSimpleModule, public ILifecycle, public INe
     virtual Result datagramLocalInHook(IPv4Datagram *datagram, const InterfaceEntry *inputInterfaceEntry) { return ACCEPT; }
     virtual Result datagramLocalOutHook(IPv4Datagram *datagram, const InterfaceEntry *& outputInterfaceEntry, IPv4Address& nextHopAddress) { Enter_Method("datagramLocalOutHook"); return ensureRouteForDatagram(datagram); }
     void delayDatagram(IPv4Datagram *datagram);
+    void dropDelayedDatagram(IPv4Datagram *datagram, simsignal_t signal);
+
+    /* RREQ duplicate detection */
+    bool isDuplicateRREQ(const RREQIdentifier& rreqIdentifier);
+    void addRREQIdentifier(const RREQIdentifier& rreqIdentifier);
+    void expungeRREQIdentifiers();
 
     /* Helper functions */
     IPv4Address getSelfIPAddress() const;
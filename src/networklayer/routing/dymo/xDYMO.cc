@@ -31,6 +31,9 @@ DYMO_NAMESPACE_BEGIN
 
 Define_Module(DYMO::xDYMO);
 
+simsignal_t xDYMO::dropPkBufferOverflowSignal = registerSignal("dropPkBufferOverflow");
+simsignal_t xDYMO::dropPkNoRouteSignal = registerSignal("dropPkNoRoute");
+
 #define DYMO_EV EV << "DYMO at " << getHostName() << " "
 
 //
@@ -43,6 +46,7 @@ xDYMO::xDYMO()
     routingTable = NULL;
     networkProtocol = NULL;
     expungeTimer = NULL;
+    sendScheduler = NULL;
     nb = NULL;
 }
 
@@ -51,6 +55,7 @@ xDYMO::~xDYMO()
     for (std::map<IPv4Address, RREQTimer *>::iterator it = targetAddressToRREQTimer.begin(); it != targetAddressToRREQTimer.end(); it++)
         cancelAndDelete(it->second);
     cancelAndDelete(expungeTimer);
+    delete sendScheduler;
     nb = NotificationBoardAccess().getIfExists(this);
     if (nb)
         nb->unsubscribe(this, NF_LINK_BREAK);
@@ -80,6 +85,10 @@ void xDYMO::initialize(int stage)
         appendInformation = par("appendInformation");
         bufferSizePackets = par("bufferSizePackets");
         bufferSizeBytes = par("bufferSizeBytes");
+        if (bufferSizePackets == 0 || bufferSizePackets < -1)
+            throw cRuntimeError("Invalid bufferSizePackets=%d, must be positive or -1", bufferSizePackets);
+        if (bufferSizeBytes == 0 || bufferSizeBytes < -1)
+            throw cRuntimeError("Invalid bufferSizeBytes=%d, must be positive or -1", bufferSizeBytes);
         // DYMO extension parameters
         maxJitter = par("maxJitter");
         sendIntermediateRREP = par("sendIntermediateRREP");
@@ -93,6 +102,7 @@ void xDYMO::initialize(int stage)
         networkProtocol = check_and_cast<INetfilter *>(getModuleByPath(par("networkProtocolModule")));
         // internal
         expungeTimer = new cMessage("ExpungeTimer");
+        sendScheduler = new JitteredSendScheduler(this, "ipOut", par("jitterCoalescingWindow"), "DYMOJitteredSendTimer");
     }
     else if (stage == 4)
     {
@@ -128,6 +138,12 @@ void xDYMO::initialize(int stage)
     }
 }
 
+void xDYMO::finish()
+{
+    recordScalar("jittered packets sent", sendScheduler->getNumSent());
+    recordScalar("jittered send batches", sendScheduler->getNumBatches());
+}
+
 void xDYMO::handleMessage(cMessage * message)
 {
     if (!isNodeUp())
@@ -146,6 +162,8 @@ void xDYMO::processSelfMessage(cMessage * message)
 {
     if (message == expungeTimer)
         processExpungeTimer();
+    else if (sendScheduler->isTimer(message))
+        sendScheduler->handleTimer(message);
     else if (dynamic_cast<RREQWaitRREPTimer *>(message))
         processRREQWaitRREPTimer((RREQWaitRREPTimer *)message);
     else if (dynamic_cast<RREQBackoffTimer *>(message))
@@ -201,8 +219,10 @@ void xDYMO::cancelRouteDiscovery(const IPv4Address & target)
     ASSERT(hasOngoingRouteDiscovery(target));
     std::multimap<IPv4Address, IPv4Datagram *>::iterator lt = targetAddressToDelayedPackets.lower_bound(target);
     std::multimap<IPv4Address, IPv4Datagram *>::iterator ut = targetAddressToDelayedPackets.upper_bound(target);
-    for (std::multimap<IPv4Address, IPv4Datagram *>::iterator it = lt; it != ut; it++)
+    for (std::multimap<IPv4Address, IPv4Datagram *>::iterator it = lt; it != ut; it++) {
+        emit(dropPkNoRouteSignal, it->second);
         dropDelayedDatagram(it->second);
+    }
     eraseDelayedDatagrams(target);
 }
 
@@ -215,11 +235,40 @@ bool xDYMO::hasOngoingRouteDiscovery(const IPv4Address & target)
 // handling IP datagrams
 //
 
-void xDYMO::delayDatagram(IPv4Datagram * datagram)
+bool xDYMO::delayDatagram(IPv4Datagram * datagram)
 {
-    DYMO_EV << "Queuing datagram: source = " << datagram->getSrcAddress() << ", destination = " << datagram->getDestAddress() << endl;
     const IPv4Address & target = datagram->getDestAddress();
+    // 7.1. Route Discovery Retries and Buffering
+    // a datagram that does not fit even into an empty buffer is not queued
+    if ((bufferSizePackets != -1 && bufferSizePackets < 1) ||
+        (bufferSizeBytes != -1 && datagram->getByteLength() > bufferSizeBytes)) {
+        DYMO_EV << "Datagram does not fit into the buffer: source = " << datagram->getSrcAddress() << ", destination = " << datagram->getDestAddress() << endl;
+        emit(dropPkBufferOverflowSignal, datagram);
+        return false;
+    }
+    DYMO_EV << "Queuing datagram: source = " << datagram->getSrcAddress() << ", destination = " << datagram->getDestAddress() << endl;
+    // the oldest datagrams of the target are dropped when its buffer is full
+    if (bufferSizePackets != -1 || bufferSizeBytes != -1) {
+        std::multimap<IPv4Address, IPv4Datagram *>::iterator lt = targetAddressToDelayedPackets.lower_bound(target);
+        std::multimap<IPv4Address, IPv4Datagram *>::iterator ut = targetAddressToDelayedPackets.upper_bound(target);
+        int packetCount = 0;
+        int64 byteCount = 0;
+        for (std::multimap<IPv4Address, IPv4Datagram *>::iterator it = lt; it != ut; it++) {
+            packetCount++;
+            byteCount += it->second->getByteLength();
+        }
+        while (lt != ut && ((bufferSizePackets != -1 && packetCount + 1 > bufferSizePackets) ||
+                            (bufferSizeBytes != -1 && byteCount + datagram->getByteLength() > bufferSizeBytes))) {
+            IPv4Datagram * oldestDatagram = lt->second;
+            packetCount--;
+            byteCount -= oldestDatagram->getByteLength();
+            targetAddressToDelayedPackets.erase(lt++);
+            emit(dropPkBufferOverflowSignal, oldestDatagram);
+            dropDelayedDatagram(oldestDatagram);
+        }
+    }
     targetAddressToDelayedPackets.insert(std::pair<IPv4Address, IPv4Datagram *>(target, datagram));
+    return true;
 }
 
 void xDYMO::reinjectDelayedDatagram(IPv4Datagram * datagram)
@@ -367,10 +416,7 @@ void xDYMO::processRREQHolddownTimer(RREQHolddownTimer * message)
 
 void xDYMO::sendUDPPacket(UDPPacket * packet, double delay)
 {
-    if (delay == 0)
-        send(packet, "ipOut");
-    else
-        sendDelayed(packet, delay, "ipOut");
+    sendScheduler->sendDelayed(packet, delay);
 }
 
 void xDYMO::processUDPPacket(UDPPacket * packet)
@@ -1377,7 +1423,8 @@ INetfilter::IHook::Result xDYMO::ensureRouteForDatagram(IPv4Datagram * datagram)
         }
         else if (source.isUnspecified() || isClientAddress(source)) {
             DYMO_EV << (broken ? "Broken" : "Missing") << " route: source = " << source << ", destination = " << destination << endl;
-            delayDatagram(datagram);
+            if (!delayDatagram(datagram))
+                return DROP;
             if (!hasOngoingRouteDiscovery(destination))
                 startRouteDiscovery(destination);
             else
@@ -1413,6 +1460,7 @@ bool xDYMO::handleOperationStage(LifecycleOperation * operation, int stage, IDon
             targetAddressToSequenceNumber.clear();
             targetAddressToRREQTimer.clear();
             targetAddressToDelayedPackets.clear();
+            sendScheduler->clear();
         }
     }
     else throw cRuntimeError("Unsupported lifecycle operation '%s'", operation->getClassName());
@@ -28,6 +28,7 @@
 #include "NodeStatus.h"
 #include "NotificationBoard.h"
 #include "UDPPacket.h"
+#include "JitteredSendScheduler.h"
 #include "DYMOdefs.h"
 #include "DYMORouteData.h"
 #include "DYMO_m.h"
@@ -84,12 +85,17 @@ class INET_API xDYMO : public cSimpleModule, public ILifecycle, public INotifiab
 
     // internal
     cMessage * expungeTimer;
+    JitteredSendScheduler * sendScheduler;
     DYMOSequenceNumber sequenceNumber;
     std::map<IPv4Address, DYMOSequenceNumber> targetAddressToSequenceNumber;
     std::map<IPv4Address, RREQTimer *> targetAddressToRREQTimer;
     std::multimap<IPv4Address, IPv4Datagram *> targetAddressToDelayedPackets;
     std::vector<std::pair<IPv4Address, int> > clientAddressAndPrefixLengthPairs; // 5.3.  Router Clients and Client Networks
 
+    // statistics
+    static simsignal_t dropPkBufferOverflowSignal;
+    static simsignal_t dropPkNoRouteSignal;
+
   public:
     xDYMO();
     virtual ~xDYMO();
@@ -99,6 +105,7 @@ class INET_API xDYMO : public cSimpleModule, public ILifecycle, public INotifiab
     virtual int numInitStages() const { return 6; }
     void initialize(int stage);
     void handleMessage(cMessage * message);
+    virtual void finish();
 
   private:
     // handling messages
@@ -113,7 +120,7 @@ class INET_API xDYMO : public cSimpleModule, public ILifecycle, public INotifiab
     bool hasOngoingRouteDiscovery(const IPv4Address & target);
 
     // handling IP datagrams
-    void delayDatagram(IPv4Datagram * datagram);
+    bool delayDatagram(IPv4Datagram * datagram);
     void reinjectDelayedDatagram(IPv4Datagram * datagram);
     void dropDelayedDatagram(IPv4Datagram * datagram);
     void eraseDelayedDatagrams(const IPv4Address & target);
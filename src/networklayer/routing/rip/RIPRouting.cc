@@ -136,12 +136,14 @@ RIPRouting::RIPRouting()
     startupTimer = NULL;
     shutdownTimer = NULL;
     isOperational = false;
+    routeTableVersion = 0;
 }
 
 RIPRouting::~RIPRouting()
 {
     for (RouteVector::iterator it = ripRoutes.begin(); it != ripRoutes.end(); ++it)
         delete *it;
+    invalidateUpdateCache();
     cancelAndDelete(updateTimer);
     cancelAndDelete(triggeredUpdateTimer);
     cancelAndDelete(startupTimer);
@@ -261,6 +263,8 @@ RIPRoute* RIPRouting::importRoute(IPv4Route *route, RIPRoute::RouteType type, in
     }
 
     ripRoutes.push_back(ripRoute);
+    addRouteToIndex(ripRoute);
+    invalidateUpdateCache();
     emit(numRoutesSignal, ripRoutes.size());
     return ripRoute;
 }
@@ -362,6 +366,7 @@ void RIPRouting::receiveChangeNotification(int signalID, const cObject *obj)
                     ripRoute->setRoute(route);
                     ripRoute->setMetric(ripIe ? ripIe->metric : 1);
                     ripRoute->setChanged(true);
+                    invalidateUpdateCache();
                     triggerUpdate();
                 }
                 else
@@ -386,13 +391,16 @@ void RIPRouting::receiveChangeNotification(int signalID, const cObject *obj)
                                route->getNetmask() != IPv4Address::makeNetmask(ripRoute->getPrefixLength()) ||
                                route->getGateway() != ripRoute->getNextHop().get4() ||
                                route->getInterface() != ripRoute->getInterface();
+                removeRouteFromIndex(ripRoute);
                 ripRoute->setDestination(route->getDestination());
                 ripRoute->setPrefixLength(route->getNetmask().getNetmaskLength());
                 ripRoute->setNextHop(route->getGateway());
                 ripRoute->setInterface(route->getInterface());
+                addRouteToIndex(ripRoute);
                 if (changed)
                 {
                     ripRoute->setChanged(changed);
+                    invalidateUpdateCache();
                     triggerUpdate();
                 }
             }
@@ -500,6 +508,8 @@ void RIPRouting::stopRIPRouting()
 
     // clear data
     ripRoutes.clear();
+    routeIndex.clear();
+    invalidateUpdateCache();
     ripInterfaces.clear();
 }
 
@@ -657,6 +667,33 @@ void RIPRouting::sendRoutes(const IPvXAddress &address, int port, const RIPInter
 {
     RIP_DEBUG << "Sending " << (changedOnly ? "changed" : "all") << " routes on " << ripInterface.ie->getFullName() << std::endl;
 
+    // resend the previous full update if nothing changed or expired since then
+    int interfaceId = ripInterface.ie->getInterfaceId();
+    if (!changedOnly)
+    {
+        UpdateCache::iterator cached = updateCache.find(interfaceId);
+        if (cached != updateCache.end())
+        {
+            if (simTime() < cached->second.validUntil)
+            {
+                RIP_DEBUG << "Routes did not change since the last full update, resending it" << std::endl;
+                for (std::vector<RIPPacket*>::iterator it = cached->second.packets.begin(); it != cached->second.packets.end(); ++it)
+                {
+                    RIPPacket *packet = (*it)->dup();
+                    emit(sentUpdateSignal, packet);
+                    sendPacket(packet, address, port, ripInterface.ie);
+                }
+                return;
+            }
+            for (std::vector<RIPPacket*>::iterator it = cached->second.packets.begin(); it != cached->second.packets.end(); ++it)
+                delete *it;
+            updateCache.erase(cached);
+        }
+    }
+    UpdateCacheEntry cacheEntry;
+    cacheEntry.validUntil = SimTime::getMaxTime();
+    unsigned long version = routeTableVersion;
+
     int maxEntries = mode == RIPv2 ? 25 : (ripInterface.ie->getMTU() - 40/*IPv6_HEADER_BYTES*/ - UDP_HEADER_BYTES - RIP_HEADER_SIZE) / RIP_RTE_SIZE;
 
     RIPPacket *packet = new RIPPacket("RIP response");
@@ -673,6 +710,13 @@ void RIPRouting::sendRoutes(const IPvXAddress &address, int port, const RIPInter
         if (changedOnly && !ripRoute->isChanged())
             continue;
 
+        if (ripRoute->getType() == RIPRoute::RIP_ROUTE_RTE)
+        {
+            simtime_t expiryTime = ripRoute->getLastUpdateTime() + routeExpiryTime;
+            if (expiryTime < cacheEntry.validUntil)
+                cacheEntry.validUntil = expiryTime;
+        }
+
         // Split Horizon check:
         //   Omit routes learned from one neighbor in updates sent to that neighbor.
         //   In the case of a broadcast network, all routes learned from any neighbor on
@@ -703,6 +747,8 @@ void RIPRouting::sendRoutes(const IPvXAddress &address, int port, const RIPInter
         // if packet is full, then send it and allocate a new one
         if (k >= maxEntries)
         {
+            if (!changedOnly)
+                cacheEntry.packets.push_back(packet->dup());
             emit(sentUpdateSignal, packet);
             sendPacket(packet, address, port, ripInterface.ie);
             packet = new RIPPacket("RIP response");
@@ -716,11 +762,22 @@ void RIPRouting::sendRoutes(const IPvXAddress &address, int port, const RIPInter
     if (k > 0)
     {
         packet->setEntryArraySize(k);
+        if (!changedOnly)
+            cacheEntry.packets.push_back(packet->dup());
         emit(sentUpdateSignal, packet);
         sendPacket(packet, address, port, ripInterface.ie);
     }
     else
         delete packet;
+
+    // keep the packets, unless routes expired while they were built
+    if (!changedOnly && routeTableVersion == version)
+        updateCache[interfaceId] = cacheEntry;
+    else
+    {
+        for (std::vector<RIPPacket*>::iterator it = cacheEntry.packets.begin(); it != cacheEntry.packets.end(); ++it)
+            delete *it;
+    }
 }
 
 /**
@@ -915,6 +972,8 @@ void RIPRouting::addRoute(const IPvXAddress &dest, int prefixLength, const Inter
     ripRoute->setLastUpdateTime(simTime());
     ripRoute->setChanged(true);
     ripRoutes.push_back(ripRoute);
+    addRouteToIndex(ripRoute);
+    invalidateUpdateCache();
     emit(numRoutesSignal, ripRoutes.size());
     triggerUpdate();
 }
@@ -975,6 +1034,7 @@ void RIPRouting::updateRoute(RIPRoute *ripRoute, const InterfaceEntry *ie, const
     }
 
     ripRoute->setChanged(true);
+    invalidateUpdateCache();
     triggerUpdate();
 
     if (metric == RIP_INFINITE_METRIC && oldMetric != RIP_INFINITE_METRIC)
@@ -1044,6 +1104,7 @@ void RIPRouting::invalidateRoute(RIPRoute *ripRoute)
     }
     ripRoute->setMetric(RIP_INFINITE_METRIC);
     ripRoute->setChanged(true);
+    invalidateUpdateCache();
     triggerUpdate();
 }
 
@@ -1064,6 +1125,8 @@ void RIPRouting::purgeRoute(RIPRoute *ripRoute)
     RouteVector::iterator end = std::remove(ripRoutes.begin(), ripRoutes.end(), ripRoute);
     if (end != ripRoutes.end())
         ripRoutes.erase(end, ripRoutes.end());
+    removeRouteFromIndex(ripRoute);
+    invalidateUpdateCache();
     delete ripRoute;
 
     emit(numRoutesSignal, ripRoutes.size());
@@ -1107,6 +1170,14 @@ RIPInterfaceEntry *RIPRouting::findInterfaceById(int interfaceId)
 
 RIPRoute *RIPRouting::findRoute(const IPvXAddress &destination, int prefixLength)
 {
+    std::pair<RouteIndex::iterator,RouteIndex::iterator> range = routeIndex.equal_range(RouteKey(destination, prefixLength));
+    if (range.first == range.second)
+        return NULL;
+    RouteIndex::iterator second = range.first;
+    if (++second == range.second)
+        return range.first->second;
+
+    // more routes to the same prefix (e.g. a static and an interface route): return the first one, as before
     for (RouteVector::iterator it = ripRoutes.begin(); it != ripRoutes.end(); ++it)
         if ((*it)->getDestination() == destination && (*it)->getPrefixLength() == prefixLength)
             return *it;
@@ -1115,12 +1186,45 @@ RIPRoute *RIPRouting::findRoute(const IPvXAddress &destination, int prefixLength
 
 RIPRoute *RIPRouting::findRoute(const IPvXAddress &destination, int prefixLength, RIPRoute::RouteType type)
 {
+    std::pair<RouteIndex::iterator,RouteIndex::iterator> range = routeIndex.equal_range(RouteKey(destination, prefixLength));
+    if (range.first == range.second)
+        return NULL;
     for (RouteVector::iterator it = ripRoutes.begin(); it != ripRoutes.end(); ++it)
         if ((*it)->getType() == type && (*it)->getDestination() == destination && (*it)->getPrefixLength() == prefixLength)
             return *it;
     return NULL;
 }
 
+void RIPRouting::addRouteToIndex(RIPRoute *ripRoute)
+{
+    routeIndex.insert(std::make_pair(RouteKey(ripRoute->getDestination(), ripRoute->getPrefixLength()), ripRoute));
+}
+
+void RIPRouting::removeRouteFromIndex(RIPRoute *ripRoute)
+{
+    std::pair<RouteIndex::iterator,RouteIndex::iterator> range = routeIndex.equal_range(RouteKey(ripRoute->getDestination(), ripRoute->getPrefixLength()));
+    for (RouteIndex::iterator it = range.first; it != range.second; ++it)
+    {
+        if (it->second == ripRoute)
+        {
+            routeIndex.erase(it);
+            return;
+        }
+    }
+}
+
+/**
+ * Drops the saved full updates; called whenever a route is added, changed or removed.
+ */
+void RIPRouting::invalidateUpdateCache()
+{
+    routeTableVersion++;
+    for (UpdateCache::iterator it = updateCache.begin(); it != updateCache.end(); ++it)
+        for (std::vector<RIPPacket*>::iterator jt = it->second.packets.begin(); jt != it->second.packets.end(); ++jt)
+            delete *jt;
+    updateCache.clear();
+}
+
 RIPRoute *RIPRouting::findRoute(const IPv4Route *route)
 {
     for (RouteVector::iterator it = ripRoutes.begin(); it != ripRoutes.end(); ++it)
@@ -1160,12 +1264,14 @@ void RIPRouting::deleteInterface(const InterfaceEntry *ie)
     {
         if ((*it)->getInterface() == ie)
         {
+            removeRouteFromIndex(*it);
             it = ripRoutes.erase(it);
             emitNumRoutesSignal = true;
         }
         else
             it++;
     }
+    invalidateUpdateCache();
     if (emitNumRoutesSignal)
         emit(numRoutesSignal, ripRoutes.size());
 }
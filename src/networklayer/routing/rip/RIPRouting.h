@@ -18,6 +18,8 @@
 #ifndef __INET_RIPROUTING_H_
 #define __INET_RIPROUTING_H_
 
+#include <map>
+
 #include "INETDefs.h"
 #include "IPv4Route.h"
 #include "IRoutingTable.h"
@@ -135,6 +137,14 @@ class INET_API RIPRouting : public cSimpleModule, public INotifiable, public ILi
     enum Mode { RIPv2, RIPng };
     typedef std::vector<RIPInterfaceEntry> InterfaceVector;
     typedef std::vector<RIPRoute*> RouteVector;
+    typedef std::pair<IPvXAddress,int> RouteKey;  // destination and prefix length
+    typedef std::multimap<RouteKey,RIPRoute*> RouteIndex;
+    struct UpdateCacheEntry
+    {
+        simtime_t validUntil;             // time when the first of the included learned routes expires
+        std::vector<RIPPacket*> packets;  // the Response messages of a full update
+    };
+    typedef std::map<int,UpdateCacheEntry> UpdateCache;  // keyed by interface id
     // environment
     cModule *host;                  // the host module that owns this module
     IInterfaceTable *ift;           // interface table of the host
@@ -142,6 +152,9 @@ class INET_API RIPRouting : public cSimpleModule, public INotifiable, public ILi
     // state
     InterfaceVector ripInterfaces;  // interfaces on which RIP is used
     RouteVector ripRoutes;          // all advertised routes (imported or learned)
+    RouteIndex routeIndex;          // ripRoutes by destination and prefix length
+    UpdateCache updateCache;        // last full update sent on each interface, reused while no route changes or expires
+    unsigned long routeTableVersion; // incremented whenever ripRoutes changes
     UDPSocket socket;               // bound to the RIP port (see udpPort parameter)
     cMessage *updateTimer;          // for sending unsolicited Response messages in every ~30 seconds.
     cMessage *triggeredUpdateTimer; // scheduled when there are pending changes
@@ -171,6 +184,9 @@ class INET_API RIPRouting : public cSimpleModule, public INotifiable, public ILi
     RIPRoute *findRoute(const IPvXAddress &destination, int prefixLength, RIPRoute::RouteType type);
     RIPRoute *findRoute(const IPv4Route *route);
     RIPRoute *findRoute(const InterfaceEntry *ie, RIPRoute::RouteType type);
+    void addRouteToIndex(RIPRoute *ripRoute);
+    void removeRouteFromIndex(RIPRoute *ripRoute);
+    void invalidateUpdateCache();
     void addInterface(const InterfaceEntry *ie, cXMLElement *config);
     void deleteInterface(const InterfaceEntry *ie);
     void invalidateRoutes(const InterfaceEntry *ie);
@@ -20,6 +20,7 @@
 #include "SCTP.h"
 #include "SCTPAssociation.h"
 #include "SCTPCommand_m.h"
+#include "TimerWheel.h"
 #include "IPSocket.h"
 #include "IPv4ControlInfo.h"
 #include "IPv6ControlInfo.h"
@@ -99,6 +100,8 @@ void SCTP::initialize()
     numPacketsReceived = 0;
     numPacketsDropped = 0;
     sizeAssocMap = 0;
+    if (par("useTimerWheel").boolValue())
+        timerWheel = new TimerWheel(this, SIMTIME_ZERO, "sctpTimerWheelTick");
     nextEphemeralPort = (uint16)(intrand(10000) + 30000);
 
     cModule *netw = simulation.getSystemModule();
@@ -139,6 +142,7 @@ SCTP::~SCTP()
     {
         sctpVTagMap.clear();
     }
+    delete timerWheel;
     sctpEV3<<"after clearing maps\n";
 }
 
@@ -152,7 +156,16 @@ void SCTP::handleMessage(cMessage *msg)
 
     sctpEV3<<"\n\nSCTPMain handleMessage at "<<getFullPath()<<"\n";
 
-    if (msg->isSelfMessage())
+    if (timerWheel && timerWheel->isTick(msg))
+    {
+        while (cMessage *timer = timerWheel->popExpiredTimer())
+        {
+            SCTPAssociation *assoc = (SCTPAssociation *) timer->getContextPointer();
+            if (!assoc->processTimer(timer))
+                removeAssociation(assoc);
+        }
+    }
+    else if (msg->isSelfMessage())
     {
 
         sctpEV3<<"selfMessage\n";
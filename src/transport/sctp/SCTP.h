@@ -34,6 +34,7 @@
 
 class SCTPAssociation;
 class SCTPMessage;
+class TimerWheel;
 
 
 #define sctpEV3 (!SCTP::testing==true)?std::cerr:std::cerr
@@ -208,8 +209,10 @@ class INET_API SCTP : public cSimpleModule
         bool pktdrop;
         bool sackNow;
         uint64 numPktDropReports;
+        TimerWheel *timerWheel;     // path T3 and heartbeat timers are kept here instead of the FES if non-NULL
 
     public:
+        SCTP() : timerWheel(NULL) {}
         virtual ~SCTP();
         virtual void initialize();
         virtual void handleMessage(cMessage *msg);
@@ -1106,6 +1106,15 @@ class INET_API SCTPAssociation : public cObject
             return sctpMain->cancelEvent(msg);
         }
 
+        /** Utility: returns true if the timer is one that goes into the timer wheel of SCTP */
+        bool isPathTimer(cMessage* msg);
+
+        /** Utility: returns true if the timer is running (in the FES or in the timer wheel) */
+        bool isTimerScheduled(cMessage* msg) const;
+
+        /** Utility: returns the expiry time of a running timer */
+        simtime_t getTimerArrivalTime(cMessage* msg) const;
+
         /** Utility: sends packet to application */
         void sendToApp(cPacket* msg);
 
@@ -26,6 +26,7 @@
 #include "SCTPQueue.h"
 #include "SCTPAlgorithm.h"
 #include "common.h"
+#include "TimerWheel.h"
 
 #ifdef WITH_IPv4
 #include "IPv4InterfaceData.h"
@@ -927,7 +928,7 @@ void SCTPAssociation::tsnWasReneged(SCTPDataVariables*       chunk,
     }
     chunk->hasBeenReneged = true;
     chunk->gapReports = 1;
-    if (!chunk->getLastDestinationPath()->T3_RtxTimer->isScheduled()) {
+    if (!isTimerScheduled(chunk->getLastDestinationPath()->T3_RtxTimer)) {
         startTimer(chunk->getLastDestinationPath()->T3_RtxTimer,
                       chunk->getLastDestinationPath()->pathRto);
     }
@@ -1042,8 +1043,8 @@ SCTPEventCode SCTPAssociation::processSackArrived(SCTPSackChunk* sackChunk)
         SCTPPathVariables* myPath = piter->second;
         sctpEV3 << "Path " << myPath->remoteAddress << ":\t"
                 << "outstanding="          << path->outstandingBytes << "\t"
-                << "T3scheduled="          << path->T3_RtxTimer->getArrivalTime() << " "
-                << (path->T3_RtxTimer->isScheduled() ? "[ok]" : "[NOT SCHEDULED]") << "\t"
+                << "T3scheduled="          << getTimerArrivalTime(path->T3_RtxTimer) << " "
+                << (isTimerScheduled(path->T3_RtxTimer) ? "[ok]" : "[NOT SCHEDULED]") << "\t"
                 << "findPseudoCumAck="    << ((myPath->findPseudoCumAck == true) ? "true" : "false")    << "\t"
                 << "pseudoCumAck="        << myPath->pseudoCumAck    << "\t"
                 << "newPseudoCumAck="     << ((myPath->newPseudoCumAck == true) ? "true" : "false")     << "\t"
@@ -1197,6 +1198,10 @@ SCTPEventCode SCTPAssociation::processSackArrived(SCTPSackChunk* sackChunk)
     }
 
 
+    // Chunks of the retransmission queue within a TSN range; the queue is
+    // walked per range instead of looking up every single TSN.
+    std::vector<SCTPDataVariables*> rangeChunks;
+
     // ====== Handle reneging ================================================
     if ((numGaps == 0) && (tsnLt(tsna, state->highestTsnAcked))) {
         // Reneging, type 0:
@@ -1206,15 +1211,13 @@ SCTPEventCode SCTPAssociation::processSackArrived(SCTPSackChunk* sackChunk)
         //      => new highestTsnAcked = CumAck
         sctpEV3 << "numGaps=0 && tsna " << tsna
                   << " < highestTsnAcked " << state->highestTsnAcked << endl;
-        uint32 i = state->highestTsnAcked;
-        while (i >= tsna + 1) {
-            SCTPDataVariables* myChunk = retransmissionQ->getChunk(i);
-            if (myChunk) {
-                if (chunkHasBeenAcked(myChunk)) {
-                    tsnWasReneged(myChunk, path, 0);
-                }
+        rangeChunks.clear();
+        retransmissionQ->getChunksInRange(tsna + 1, state->highestTsnAcked, rangeChunks);
+        for (int32 i = (int32)rangeChunks.size() - 1; i >= 0; i--) {
+            SCTPDataVariables* myChunk = rangeChunks[i];
+            if (chunkHasBeenAcked(myChunk)) {
+                tsnWasReneged(myChunk, path, 0);
             }
-            i--;
         }
         state->highestTsnAcked = tsna;
     }
@@ -1242,21 +1245,16 @@ SCTPEventCode SCTPAssociation::processSackArrived(SCTPSackChunk* sackChunk)
             // This SACK contains a last gap ack < highestTsnAcked
             //      => rereg TSNs from last gap ack to highestTsnAcked
             //      => new highestTsnAcked = last gap ack
-            uint32 i = state->highestTsnAcked;
-            while (i >= sackGapList.getGapStop(SCTPGapList::GT_Any, numGaps - 1) + 1) {
-                // ====== Looking up TSN in retransmission queue ================
-                SCTPDataVariables* myChunk = retransmissionQ->getChunk(i);
-                if (myChunk) {
-                    if (chunkHasBeenAcked(myChunk)) {
-                        sctpEV3 << "TSN " << i << " was found. It has been un-acked." << endl;
-                        tsnWasReneged(myChunk, path, 2);
-                        sctpEV3 << "highestTsnAcked now " << state->highestTsnAcked << endl;
-                    }
-                }
-                else {
-                    sctpEV3 << "TSN " << i << " not found in retransmissionQ" << endl;
+            rangeChunks.clear();
+            retransmissionQ->getChunksInRange(sackGapList.getGapStop(SCTPGapList::GT_Any, numGaps - 1) + 1,
+                                              state->highestTsnAcked, rangeChunks);
+            for (int32 i = (int32)rangeChunks.size() - 1; i >= 0; i--) {
+                SCTPDataVariables* myChunk = rangeChunks[i];
+                if (chunkHasBeenAcked(myChunk)) {
+                    sctpEV3 << "TSN " << myChunk->tsn << " was found. It has been un-acked." << endl;
+                    tsnWasReneged(myChunk, path, 2);
+                    sctpEV3 << "highestTsnAcked now " << state->highestTsnAcked << endl;
                 }
-                i--;
             }
             state->highestTsnAcked = sackGapList.getGapStop(SCTPGapList::GT_Any, numGaps - 1);
         }
@@ -1265,71 +1263,56 @@ SCTPEventCode SCTPAssociation::processSackArrived(SCTPSackChunk* sackChunk)
         sctpEV3 << "Looking for changes in gap reports" << endl;
         // Get Pseudo CumAck for paths
         uint32 lo1 = tsna;
-        uint32 tsnCheck = tsna + 1;   // Just to make sure that no TSN is misssed
         for (int32 key = 0; key < numGaps; key++) {
             const uint32 lo = sackGapList.getGapStart(SCTPGapList::GT_Any, key);
             const uint32 hi = sackGapList.getGapStop(SCTPGapList::GT_Any, key);
 
             // ====== Iterate over TSNs *not* listed in gap reports ============
-            for (uint32 pos = lo1+1; pos <= lo-1;pos++) {
-                assert(tsnCheck == pos);   tsnCheck++;
-                SCTPDataVariables* myChunk = retransmissionQ->getChunk(pos);
-                if(myChunk) {
-                    SCTPPathVariables* myChunkLastPath = myChunk->getLastDestinationPath();
-                    assert(myChunkLastPath != NULL);
-                    // T.D. 22.11.09: CUCv2 - chunk is *not* acked
-                    cucProcessGapReports(myChunk, myChunkLastPath, false);
-                }
-            }
-            lo1 = sackGapList.getGapStop(SCTPGapList::GT_Any, key);
+            rangeChunks.clear();
+            retransmissionQ->getChunksInRange(lo1 + 1, lo - 1, rangeChunks);
+            for (uint32 i = 0; i < rangeChunks.size(); i++) {
+                SCTPDataVariables* myChunk = rangeChunks[i];
+                SCTPPathVariables* myChunkLastPath = myChunk->getLastDestinationPath();
+                assert(myChunkLastPath != NULL);
+                // T.D. 22.11.09: CUCv2 - chunk is *not* acked
+                cucProcessGapReports(myChunk, myChunkLastPath, false);
+            }
+            lo1 = hi;
             // ====== Iterate over TSNs in gap reports =========================
+            // Chunks which are not in the retransmission queue any more have
+            // already been NR-acked and need no further processing.
             sctpEV3 << "Examine TSNs between " << lo << " and " << hi << endl;
-            for (uint32 pos = lo; pos <= hi; pos++) {
-                bool chunkFirstTime = true;
-                assert(tsnCheck == pos);   tsnCheck++;
-                SCTPDataVariables* myChunk = retransmissionQ->getChunkFast(pos, chunkFirstTime);
-                if (myChunk) {
-                    if (chunkHasBeenAcked(myChunk) == false) {
-                        SCTPPathVariables* myChunkLastPath = myChunk->getLastDestinationPath();
-                        assert(myChunkLastPath != NULL);
-                        // CUCv2 - chunk is acked
-                        cucProcessGapReports(myChunk, myChunkLastPath, true);
-                        // This chunk has been acked newly.
-                        // Let's process this new acknowledgement!
-                        handleChunkReportedAsAcked(highestNewAck, rttEstimation, myChunk,
-                                path /* i.e. the SACK path for RTT measurement! */,
-                                sackGapList.tsnIsNonRevokable(myChunk->tsn));
-                    }
-                    else {
-                        // Slow Path RTT Calculation
-                        if( (path->tsnForRTTCalculation == myChunk->tsn) &&
-                            (path->waitingForRTTCalculaton == true) &&
-                            (state->allowCMT == true) &&
-                            (state->cmtSlowPathRTTUpdate == true) &&
-                            (myChunk->getLastDestinationPath() == path) ) {
-                            const simtime_t rttEstimation = simTime() - path->txTimeForRTTCalculation;
-                            path->waitingForRTTCalculaton = false;
-                            pmRttMeasurement(path, rttEstimation);
-
-                            sctpEV3 << simTime() << ": SlowPathRTTUpdate from gap report - rtt="
-                                    << rttEstimation << " from TSN "
-                                    << path->tsnForRTTCalculation
-                                    << " on path " << path->remoteAddress
-                                    << " => RTO=" << path->pathRto << endl;
-                        }
-                    }
+            rangeChunks.clear();
+            retransmissionQ->getChunksInRange(lo, hi, rangeChunks);
+            for (uint32 i = 0; i < rangeChunks.size(); i++) {
+                SCTPDataVariables* myChunk = rangeChunks[i];
+                if (chunkHasBeenAcked(myChunk) == false) {
+                    SCTPPathVariables* myChunkLastPath = myChunk->getLastDestinationPath();
+                    assert(myChunkLastPath != NULL);
+                    // CUCv2 - chunk is acked
+                    cucProcessGapReports(myChunk, myChunkLastPath, true);
+                    // This chunk has been acked newly.
+                    // Let's process this new acknowledgement!
+                    handleChunkReportedAsAcked(highestNewAck, rttEstimation, myChunk,
+                            path /* i.e. the SACK path for RTT measurement! */,
+                            sackGapList.tsnIsNonRevokable(myChunk->tsn));
                 }
-
-                // ====== R-acked chunk became NR-acked =========================
-                else if (sackGapList.tsnIsNonRevokable(pos)) {
-                    bool chunkFirstTime = false;
-                    SCTPDataVariables* myChunk = retransmissionQ->getChunkFast(pos, chunkFirstTime);
-                    if (myChunk) {
-                        // myChunk != NULL -> R-acked before, but not NR-acked
-                        handleChunkReportedAsAcked(highestNewAck, rttEstimation, myChunk,
-                                path /* i.e. the SACK path for RTT measurement! */,
-                                sackGapList.tsnIsNonRevokable(myChunk->tsn));
-                        // All NR-acked chunks have chunkMap->getChunk(pos) == NULL!
+                else {
+                    // Slow Path RTT Calculation
+                    if( (path->tsnForRTTCalculation == myChunk->tsn) &&
+                        (path->waitingForRTTCalculaton == true) &&
+                        (state->allowCMT == true) &&
+                        (state->cmtSlowPathRTTUpdate == true) &&
+                        (myChunk->getLastDestinationPath() == path) ) {
+                        const simtime_t rttEstimation = simTime() - path->txTimeForRTTCalculation;
+                        path->waitingForRTTCalculaton = false;
+                        pmRttMeasurement(path, rttEstimation);
+
+                        sctpEV3 << simTime() << ": SlowPathRTTUpdate from gap report - rtt="
+                                << rttEstimation << " from TSN "
+                                << path->tsnForRTTCalculation
+                                << " on path " << path->remoteAddress
+                                << " => RTO=" << path->pathRto << endl;
                     }
                 }
             }
@@ -1341,16 +1324,11 @@ SCTPEventCode SCTPAssociation::processSackArrived(SCTPSackChunk* sackChunk)
         uint32 lo = tsna;
         for (int32 key = 0; key < numGaps; key++) {
             const uint32 hi = sackGapList.getGapStart(SCTPGapList::GT_Any, key);
-            for (uint32 pos = lo+1; pos <= hi - 1; pos++) {
-                bool chunkFirstTime = true;
-                SCTPDataVariables* myChunk = retransmissionQ->getChunkFast(pos, chunkFirstTime);
-                if (myChunk) {
-                    handleChunkReportedAsMissing(sackChunk, highestNewAck, myChunk,
-                                                          path /* i.e. the SACK path for RTT measurement! */);
-                }
-                else {
-                    sctpEV3 << "TSN " << pos << " not found in retransmissionQ" << endl;
-                }
+            rangeChunks.clear();
+            retransmissionQ->getChunksInRange(lo + 1, hi - 1, rangeChunks);
+            for (uint32 i = 0; i < rangeChunks.size(); i++) {
+                handleChunkReportedAsMissing(sackChunk, highestNewAck, rangeChunks[i],
+                                             path /* i.e. the SACK path for RTT measurement! */);
             }
             lo = sackGapList.getGapStop(SCTPGapList::GT_Any, key);
         }
@@ -3062,13 +3040,40 @@ void SCTPAssociation::stopTimer(cMessage* timer)
     if (timer->isScheduled()) {
         cancelEvent(timer);
     }
+    else if (sctpMain->timerWheel) {
+        sctpMain->timerWheel->cancel(timer);
+    }
 }
 
 void SCTPAssociation::startTimer(cMessage* timer, const simtime_t& timeout)
 {
     sctpEV3 << "startTimer " << timer->getName() << " with timeout "
               << timeout << " to expire at " << simTime() + timeout << endl;
-    scheduleTimeout(timer, timeout);
+    if (sctpMain->timerWheel && isPathTimer(timer))
+        sctpMain->timerWheel->scheduleAt(simTime() + timeout, timer);
+    else
+        scheduleTimeout(timer, timeout);
+}
+
+bool SCTPAssociation::isPathTimer(cMessage* timer)
+{
+    SCTPPathInfo* pinfo = dynamic_cast<SCTPPathInfo*>(timer->getControlInfo());
+    if (pinfo == NULL)
+        return false;
+    SCTPPathVariables* path = getPath(pinfo->getRemoteAddress());
+    return path != NULL && (timer == path->T3_RtxTimer || timer == path->HeartbeatTimer || timer == path->HeartbeatIntervalTimer);
+}
+
+bool SCTPAssociation::isTimerScheduled(cMessage* timer) const
+{
+    return timer->isScheduled() || (sctpMain->timerWheel && sctpMain->timerWheel->isScheduled(timer));
+}
+
+simtime_t SCTPAssociation::getTimerArrivalTime(cMessage* timer) const
+{
+    if (!timer->isScheduled() && sctpMain->timerWheel && sctpMain->timerWheel->isScheduled(timer))
+        return sctpMain->timerWheel->getArrivalTime(timer);
+    return timer->getArrivalTime();
 }
 
 void SCTPAssociation::process_TIMEOUT_RESET(SCTPPathVariables* path)
@@ -367,7 +367,7 @@ void SCTPAssociation::chunkReschedulingControl(SCTPPathVariables* path)
 
 
     sctpEV3 << " - "          << path->remoteAddress
-            << "\tt3="        << (path->T3_RtxTimer->isScheduled() ? path->T3_RtxTimer->getArrivalTime().dbl() : -1.0)
+            << "\tt3="        << (isTimerScheduled(path->T3_RtxTimer) ? getTimerArrivalTime(path->T3_RtxTimer).dbl() : -1.0)
             << "\tssthresh="  << path->ssthresh
             << "\tcwnd="      << path->cwnd
             << "\tsrtt="      << path->srtt
@@ -428,7 +428,7 @@ void SCTPAssociation::chunkReschedulingControl(SCTPPathVariables* path)
                         chunk->hasBeenMoved = (lastPath != path);
 
                         // Restart T3 timer on its old path, if it is scheduled
-                        if(lastPath->T3_RtxTimer->isScheduled()) {
+                        if(isTimerScheduled(lastPath->T3_RtxTimer)) {
                             // Stop timer, if path is empty now.
                             // Else, keep it running, without reset!
                             if(lastPath->queuedBytes == 0) {
@@ -835,7 +835,7 @@ void SCTPAssociation::sendOnPath(SCTPPathVariables* pathId, bool firstPass)
                 authAdded = addAuthChunkIfNecessary(sctpMsg, FORWARD_TSN, authAdded);
                 sctpMsg->addChunk(forwardChunk);
                 forwardPresent = true;
-                if (!path->T3_RtxTimer->isScheduled()) {
+                if (!isTimerScheduled(path->T3_RtxTimer)) {
                     // Start retransmission timer, if not scheduled before
                     startTimer(path->T3_RtxTimer, path->pathRto);
                 }
@@ -980,7 +980,7 @@ void SCTPAssociation::sendOnPath(SCTPPathVariables* pathId, bool firstPass)
                             authAdded = addAuthChunkIfNecessary(sctpMsg, FORWARD_TSN, authAdded);
                             sctpMsg->addChunk(forwardChunk);
                             forwardPresent = true;
-                            if (!path->T3_RtxTimer->isScheduled()) {
+                            if (!isTimerScheduled(path->T3_RtxTimer)) {
                                 // Start retransmission timer, if not scheduled before
                                 startTimer(path->T3_RtxTimer, path->pathRto);
                             }
@@ -1342,7 +1342,7 @@ void SCTPAssociation::sendOnPath(SCTPPathVariables* pathId, bool firstPass)
                         /* new chunks would exceed MTU, so we send old packet and build a new one */
                         /* this implies that at least one data chunk is send here */
                         if (dataChunksAdded > 0) {
-                            if (!path->T3_RtxTimer->isScheduled()) {
+                            if (!isTimerScheduled(path->T3_RtxTimer)) {
                                 // Start retransmission timer, if not scheduled before
                                 startTimer(path->T3_RtxTimer, path->pathRto);
                             }
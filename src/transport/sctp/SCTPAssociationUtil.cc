@@ -2684,11 +2684,9 @@ void SCTPAssociation::pmStartPathManagement()
 
 int32 SCTPAssociation::getOutstandingBytes() const
 {
-    int32 osb = 0;
-    for (SCTPPathMap::const_iterator pm = sctpPathMap.begin(); pm != sctpPathMap.end(); pm++) {
-        osb += pm->second->outstandingBytes;
-    }
-    return osb;
+    // state->outstandingBytes is kept in step with the per-path counters
+    // whenever a chunk is sent or acked, so there is no need to sum up the paths.
+    return (int32)state->outstandingBytes;
 }
 
 void SCTPAssociation::pmClearPathCounter(SCTPPathVariables* path)
@@ -23,10 +23,8 @@
 SCTPSimpleGapList::SCTPSimpleGapList()
 {
     NumGaps = 0;
-    for (unsigned int i = 0; i < MAX_GAP_COUNT; i++) {
-        GapStartList[i] = 0xffff00ff;
-        GapStopList[i] = 0xffff0000;
-    }
+    GapStartList.resize(INITIAL_GAP_COUNT, 0xffff00ff);
+    GapStopList.resize(INITIAL_GAP_COUNT, 0xffff0000);
 }
 
 
@@ -65,15 +63,31 @@ void SCTPSimpleGapList::print(std::ostream& os) const
 }
 
 
-// ###### Is TSN in gap list? ###############################################
-bool SCTPSimpleGapList::tsnInGapList(const uint32 tsn) const
+// ###### Find first gap starting after TSN #################################
+uint32 SCTPSimpleGapList::findFirstGapAfter(const uint32 tsn) const
 {
-    for (uint32 i = 0; i < NumGaps; i++) {
-        if (SCTPAssociation::tsnBetween(GapStartList[i], tsn, GapStopList[i])) {
-            return true;
+    // The gaps are sorted and lie within one TSN window, so the serial
+    // number comparison is a total order on them.
+    uint32 lo = 0;
+    uint32 hi = NumGaps;
+    while (lo < hi) {
+        const uint32 mid = (lo + hi) / 2;
+        if (SCTPAssociation::tsnGt(GapStartList[mid], tsn)) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
         }
     }
-    return false;
+    return (lo);
+}
+
+
+// ###### Is TSN in gap list? ###############################################
+bool SCTPSimpleGapList::tsnInGapList(const uint32 tsn) const
+{
+    const uint32 i = findFirstGapAfter(tsn);
+    return ((i > 0) && (SCTPAssociation::tsnLe(tsn, GapStopList[i - 1])));
 }
 
 
@@ -149,7 +163,8 @@ void SCTPSimpleGapList::removeFromGapList(const uint32 removedTSN)
                     GapStartList[i]++;
                 }
                 else {   // Block has to be splitted up
-                    NumGaps = std::min(NumGaps + 1, (uint32)MAX_GAP_COUNT);   // Enforce upper limit!
+                    reserveGaps(NumGaps + 1);
+                    NumGaps++;
                     for (int32 j = NumGaps - 1;  j > i; j--) {
                         GapStopList[j] = GapStopList[j - 1];
                         GapStartList[j] = GapStartList[j - 1];
@@ -188,85 +203,88 @@ bool SCTPSimpleGapList::updateGapList(const uint32 receivedTSN,
         return (false);
     }
 
-    uint32 lo = cTsnAck + 1;
-    for (uint32 i = 0; i < NumGaps; i++) {
-        if (GapStartList[i] > 0) {
-            const uint32 hi = GapStartList[i] - 1;
-            if (SCTPAssociation::tsnBetween(lo, receivedTSN, hi)) {
-                const uint32 gapsize = hi - lo + 1;
-                if (gapsize > 1) {
-                    /**
-                     * TSN either sits at the end of one gap, and thus changes gap
-                     * boundaries, or it is in between two gaps, and becomes a new gap
-                     */
-                    if (receivedTSN == hi) {
-                        GapStartList[i] = receivedTSN;
-                        newChunkReceived = true;
-                        return true;
-                    }
-                    else if (receivedTSN == lo) {
-                        if (receivedTSN == (cTsnAck + 1)) {
-                            cTsnAck++;
-                            newChunkReceived = true;
-                            return true;
-                        }
-                        /* some gap must increase its upper bound */
-                        GapStopList[i-1] = receivedTSN;
+    // Gaps starting at or before receivedTSN cannot have a hole containing
+    // it, so skip them. Appending behind the last gap (the common case
+    // when a SACK is parsed) then needs no walk over the list at all.
+    const uint32 first = findFirstGapAfter(receivedTSN);
+    uint32 lo = (first > 0) ? GapStopList[first - 1] + 1 : cTsnAck + 1;
+    for (uint32 i = first; i < NumGaps; i++) {
+        const uint32 hi = GapStartList[i] - 1;
+        if (SCTPAssociation::tsnBetween(lo, receivedTSN, hi)) {
+            const uint32 gapsize = hi - lo + 1;
+            if (gapsize > 1) {
+                /**
+                 * TSN either sits at the end of one gap, and thus changes gap
+                 * boundaries, or it is in between two gaps, and becomes a new gap
+                 */
+                if (receivedTSN == hi) {
+                    GapStartList[i] = receivedTSN;
+                    newChunkReceived = true;
+                    return true;
+                }
+                else if (receivedTSN == lo) {
+                    if (receivedTSN == (cTsnAck + 1)) {
+                        cTsnAck++;
                         newChunkReceived = true;
                         return true;
                     }
-                    else {   /* a gap in between */
-                        NumGaps = std::min(NumGaps + 1, (uint32)MAX_GAP_COUNT);   //  Enforce upper limit!
+                    /* some gap must increase its upper bound */
+                    GapStopList[i-1] = receivedTSN;
+                    newChunkReceived = true;
+                    return true;
+                }
+                else {   /* a gap in between */
+                    reserveGaps(NumGaps + 1);
+                    NumGaps++;
 
-                        for (uint32 j = NumGaps - 1; j > i; j--) {
-                            GapStartList[j] = GapStartList[j-1];
-                            GapStopList[j] = GapStopList[j-1];
-                        }
-                        GapStartList[i] = receivedTSN;
-                        GapStopList[i] = receivedTSN;
-                        newChunkReceived = true;
-                        return true;
+                    for (uint32 j = NumGaps - 1; j > i; j--) {
+                        GapStartList[j] = GapStartList[j-1];
+                        GapStopList[j] = GapStopList[j-1];
                     }
+                    GapStartList[i] = receivedTSN;
+                    GapStopList[i] = receivedTSN;
+                    newChunkReceived = true;
+                    return true;
                 }
-                else {   /* alright: gapsize is 1: our received tsn may close gap between fragments */
-                    if (lo == cTsnAck + 1) {
-                        cTsnAck = GapStopList[i];
-                        if (i == NumGaps-1) {
-                            GapStartList[i] = 0;
-                            GapStopList[i] = 0;
-                        }
-                        else {
-                            for (uint32 j = i; j < NumGaps - 1; j++) {
-                                GapStartList[j] = GapStartList[j + 1];
-                                GapStopList[j] = GapStopList[j + 1];
-                            }
-                        }
-                        NumGaps--;
-                        newChunkReceived = true;
-                        return true;
+            }
+            else {   /* alright: gapsize is 1: our received tsn may close gap between fragments */
+                if (lo == cTsnAck + 1) {
+                    cTsnAck = GapStopList[i];
+                    if (i == NumGaps-1) {
+                        GapStartList[i] = 0;
+                        GapStopList[i] = 0;
                     }
                     else {
-                        GapStopList[i-1] = GapStopList[i];
-                        if (i == NumGaps-1) {
-                            GapStartList[i] = 0;
-                            GapStopList[i] = 0;
+                        for (uint32 j = i; j < NumGaps - 1; j++) {
+                            GapStartList[j] = GapStartList[j + 1];
+                            GapStopList[j] = GapStopList[j + 1];
                         }
-                        else {
-                            for (uint32 j = i; j < NumGaps - 1; j++) {
-                                GapStartList[j] = GapStartList[j + 1];
-                                GapStopList[j] = GapStopList[j + 1];
-                            }
+                    }
+                    NumGaps--;
+                    newChunkReceived = true;
+                    return true;
+                }
+                else {
+                    GapStopList[i-1] = GapStopList[i];
+                    if (i == NumGaps-1) {
+                        GapStartList[i] = 0;
+                        GapStopList[i] = 0;
+                    }
+                    else {
+                        for (uint32 j = i; j < NumGaps - 1; j++) {
+                            GapStartList[j] = GapStartList[j + 1];
+                            GapStopList[j] = GapStopList[j + 1];
                         }
-                        NumGaps--;
-                        newChunkReceived = true;
-                        return true;
                     }
+                    NumGaps--;
+                    newChunkReceived = true;
+                    return true;
                 }
             }
-            else {  /* receivedTSN is not in the gap between these fragments... */
-                lo = GapStopList[i] + 1;
-            }
-        } /* end: for */
+        }
+        else {  /* receivedTSN is not in the gap between these fragments... */
+            lo = GapStopList[i] + 1;
+        }
     } /* end: for */
 
     // ====== We have reached the end of the list ============================
@@ -290,12 +308,11 @@ bool SCTPSimpleGapList::updateGapList(const uint32 receivedTSN,
         if ( (NumGaps == 0) ||
                 (SCTPAssociation::tsnGt(receivedTSN, GapStopList[NumGaps - 1] + 1)) ) {
             // A new fragment altogether, past the end of the list
-            if (NumGaps < MAX_GAP_COUNT) {   // T.D. 18.12.09: Enforce upper limit!
-                GapStartList[NumGaps] = receivedTSN;
-                GapStopList[NumGaps] = receivedTSN;
-                NumGaps++;
-                newChunkReceived = true;
-            }
+            reserveGaps(NumGaps + 1);
+            GapStartList[NumGaps] = receivedTSN;
+            GapStopList[NumGaps] = receivedTSN;
+            NumGaps++;
+            newChunkReceived = true;
         }
         return true;
     }
@@ -20,12 +20,14 @@
 #define SCTPGAPLIST_H
 
 #include <assert.h>
+#include <vector>
 
 #include "INETDefs.h"
 
 //#include "SCTPSeqNumbers.h"
 
-#define MAX_GAP_COUNT 500
+// Initial number of gap slots; the lists grow on demand
+#define INITIAL_GAP_COUNT 32
 
 
 class SCTPSimpleGapList
@@ -58,11 +60,23 @@ class SCTPSimpleGapList
                        bool&        newChunkReceived);
 
 
+    // ====== Private methods ================================================
+  private:
+    // Makes room for at least count gaps (plus one spare slot)
+    inline void reserveGaps(const uint32 count) {
+        if (count >= GapStartList.size()) {
+            GapStartList.resize(2 * count, 0xffff00ff);
+            GapStopList.resize(2 * count, 0xffff0000);
+        }
+    }
+    // Index of the first gap starting after tsn (binary search)
+    uint32 findFirstGapAfter(const uint32 tsn) const;
+
     // ====== Private data ===================================================
   private:
     uint32 NumGaps;
-    uint32 GapStartList[MAX_GAP_COUNT];
-    uint32 GapStopList[MAX_GAP_COUNT];
+    std::vector<uint32> GapStartList;
+    std::vector<uint32> GapStopList;
 };
 
 
@@ -4,6 +4,7 @@
 #include "RoutingTableAccess.h"
 #include "IPv4InterfaceData.h"
 #include "SCTPAssociation.h"
+#include "ModuleAccess.h"
 
 Define_Module(SCTPNatHook);
 
@@ -27,7 +28,7 @@ void SCTPNatHook::initialize()
     ipLayer = check_and_cast<IPv4*>(getParentModule()->getSubmodule("networkLayer")->getSubmodule("ip"));
     rt = routingTableAccess.get();
     ift = interfaceTableAccess.get();
-    natTable = new SCTPNatTable();
+    natTable = ModuleAccess<SCTPNatTable>("natTable").get();
     nattedPackets = 0;
 
     ipLayer->registerHook(0, this);
@@ -43,7 +44,6 @@ INetfilter::IHook::Result SCTPNatHook::datagramForwardHook(IPv4Datagram* datagra
     if (SCTPAssociation::getAddressLevel(dgram->getSrcAddress())!=3) {
         return INetfilter::IHook::ACCEPT;
     }
-    natTable->printNatTable();
     SCTPMessage* sctpMsg = check_and_cast<SCTPMessage*>(dgram->getEncapsulatedPacket());
     unsigned int numberOfChunks=sctpMsg->getChunksArraySize();
     if (numberOfChunks==1)
@@ -78,7 +78,7 @@ INetfilter::IHook::Result SCTPNatHook::datagramForwardHook(IPv4Datagram* datagra
         }
         dgram->setSrcAddress(outIE->ipv4Data()->getIPAddress());
         sctpMsg->setSrcPort(entry->getNattedPort());
-        natTable->natEntries.push_back(entry);
+        natTable->addNatEntry(entry);
     }
     else
     {
@@ -129,7 +129,6 @@ INetfilter::IHook::Result SCTPNatHook::datagramPreRoutingHook(IPv4Datagram* data
     if (SCTPAssociation::getAddressLevel(dgram->getSrcAddress())==3) {
         return INetfilter::IHook::ACCEPT;
     }
-    natTable->printNatTable();
     bool local = ((rt->isLocalAddress(dgram->getDestAddress()) & SCTPAssociation::getAddressLevel(dgram->getSrcAddress()))==3);
     SCTPMessage* sctpMsg = check_and_cast<SCTPMessage*>(dgram->getEncapsulatedPacket());
     unsigned int numberOfChunks=sctpMsg->getChunksArraySize();
@@ -222,9 +221,8 @@ INetfilter::IHook::Result SCTPNatHook::datagramPreRoutingHook(IPv4Datagram* data
                 entry->setNattedAddress(dgram->getDestAddress());
                 SCTPInitChunk* initChunk=check_and_cast<SCTPInitChunk*>(chunk);
                 entry->setGlobalVTag(initChunk->getInitTag());
-                natTable->natEntries.push_back(entry);
+                natTable->addNatEntry(entry);
                 sctpEV3<<"added entry for local deliver\n";
-                natTable->printNatTable();
                 return INetfilter::IHook::DROP;
             }
             else
@@ -238,13 +236,12 @@ INetfilter::IHook::Result SCTPNatHook::datagramPreRoutingHook(IPv4Datagram* data
                 entry2->setNattedAddress(entry->getGlobalAddress());
                 SCTPInitChunk* initChunk=check_and_cast<SCTPInitChunk*>(chunk);
                 entry2->setGlobalVTag(initChunk->getInitTag());
-                natTable->natEntries.push_back(entry2);
+                natTable->addNatEntry(entry2);
                 dgram->setDestAddress(entry->getLocalAddress().get4());
                 sctpMsg->setDestPort(entry->getLocalPort());
                 dgram->setSrcAddress(entry->getGlobalAddress().get4());
                 sctpMsg->setSrcPort(entry->getGlobalPort());
                 sctpEV3<<"added additional entry for local deliver\n";
-                natTable->printNatTable();
                 sctpEV3<<"destAddress set to "<<dgram->getDestAddress()<<", destPort set to "<<sctpMsg->getDestPort()<<"\n";
             }
         }
@@ -324,6 +321,5 @@ void SCTPNatHook::finish()
     if (ipLayer)
         ipLayer->unregisterHook(0, this);
     ipLayer = NULL;
-    delete natTable;
     std::cout<<getFullPath()<<": Natted packets: "<<nattedPackets<<"\n";
 }
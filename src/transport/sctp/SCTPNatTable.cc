@@ -27,107 +27,194 @@
 #include "SCTPNatTable.h"
 #include "NotifierConsts.h"
 #include "SCTPAssociation.h"
+#include "TimerWheel.h"
 
 uint32 SCTPNatTable::nextEntryNumber = 0;
 
+simsignal_t SCTPNatTable::natEntriesSignal = registerSignal("natEntries");
+
 
 Define_Module( SCTPNatTable );
 
 
-SCTPNatTable::SCTPNatTable()
+bool SCTPNatTable::EndpointPair::operator<(const EndpointPair& other) const
 {
+    if (port1 != other.port1)
+        return port1 < other.port1;
+    if (port2 != other.port2)
+        return port2 < other.port2;
+    if (!(addr1 == other.addr1))
+        return addr1 < other.addr1;
+    return addr2 < other.addr2;
+}
 
+SCTPNatTable::SCTPNatTable()
+{
+    timerWheel = NULL;
+    numLookups = 0;
+    numLookupMisses = 0;
+    numAddedEntries = 0;
+    numExpiredEntries = 0;
 }
 
 SCTPNatTable::~SCTPNatTable()
 {
-    for (uint32 i=0; i<natEntries.size(); i++)
-        delete natEntries[i];
+    delete timerWheel;
+    for (SCTPNatEntryTable::iterator i=natEntries.begin(); i!=natEntries.end(); ++i)
+        delete *i;
 }
 
-SCTPNatEntry* SCTPNatTable::findNatEntry(IPvXAddress srcAddr, uint16 srcPrt, IPvXAddress destAddr, uint16 destPrt, uint32 globalVtag)
+void SCTPNatTable::initialize()
 {
-    // linear search is OK because normally we don't have many interfaces and this func is rarely called
-    Enter_Method_Silent();
-    for (SCTPNatEntryTable::iterator i=natEntries.begin(); i!=natEntries.end(); ++i)
-        if ((*i)->getLocalAddress()==srcAddr && (*i)->getLocalPort()==srcPrt &&
-                (*i)->getGlobalAddress()==destAddr && (*i)->getGlobalPort()==destPrt && (*i)->getGlobalVTag()==globalVtag)
+    idleTimeout = par("idleTimeout");
+    if (idleTimeout > SIMTIME_ZERO)
+        timerWheel = new TimerWheel(this, par("timerWheelGranularity"), "natTimerWheelTick");
+
+    WATCH(numLookups);
+    WATCH(numLookupMisses);
+    WATCH(numAddedEntries);
+    WATCH(numExpiredEntries);
+}
+
+void SCTPNatTable::handleMessage(cMessage *msg)
+{
+    if (timerWheel && timerWheel->isTick(msg))
+    {
+        while (cMessage *timer = timerWheel->popExpiredTimer())
         {
-            return *i;
+            SCTPNatEntry *entry = (SCTPNatEntry *)timer->getContextPointer();
+            sctpEV3 << "NAT entry " << entry->getLocalAddress() << ":" << entry->getLocalPort() << " <-> "
+                    << entry->getGlobalAddress() << ":" << entry->getGlobalPort() << " expired\n";
+            numExpiredEntries++;
+            removeEntry(entry);
         }
-    return NULL;
+    }
+    else
+        throw cRuntimeError("Unexpected message: %s", msg->getName());
 }
 
-SCTPNatEntry* SCTPNatTable::getEntry(IPvXAddress globalAddr, uint16 globalPrt, IPvXAddress nattedAddr, uint16 nattedPrt, uint32 localVtag)
+void SCTPNatTable::finish()
 {
-    // linear search is OK because normally we don't have many interfaces and this func is rarely called
-    Enter_Method_Silent();
-    for (SCTPNatEntryTable::iterator i=natEntries.begin(); i!=natEntries.end(); ++i)
-        if ((*i)->getGlobalAddress()==globalAddr && (*i)->getGlobalPort()==globalPrt &&
-                (*i)->getNattedAddress()==nattedAddr && (*i)->getNattedPort()==nattedPrt &&
-                (*i)->getLocalVTag()==localVtag)
-            //  (*i)->getGlobalVTag()==localVtag)
+    recordScalar("NAT lookups", numLookups);
+    recordScalar("NAT lookup misses", numLookupMisses);
+    recordScalar("NAT entries added", numAddedEntries);
+    recordScalar("NAT entries expired", numExpiredEntries);
+}
+
+void SCTPNatTable::addToIndex(SCTPNatEntryIndex& index, const EndpointPair& key, SCTPNatEntry *entry)
+{
+    // equal keys keep their insertion order, so lookups return the oldest matching entry
+    index.insert(std::make_pair(key, entry));
+}
+
+void SCTPNatTable::removeFromIndex(SCTPNatEntryIndex& index, const EndpointPair& key, SCTPNatEntry *entry)
+{
+    std::pair<SCTPNatEntryIndex::iterator, SCTPNatEntryIndex::iterator> range = index.equal_range(key);
+    for (SCTPNatEntryIndex::iterator i=range.first; i!=range.second; ++i)
+        if (i->second == entry)
         {
-            return *i;
+            index.erase(i);
+            return;
         }
-    return NULL;
 }
 
-SCTPNatEntry* SCTPNatTable::getSpecialEntry(IPvXAddress globalAddr, uint16 globalPrt, IPvXAddress nattedAddr, uint16 nattedPrt)
+void SCTPNatTable::restartIdleTimer(SCTPNatEntry *entry)
 {
-    // linear search is OK because normally we don't have many interfaces and this func is rarely called
-    Enter_Method_Silent();
+    if (!timerWheel)
+        return;
+    // cheap: the wheel leaves a timer that moves to a later time in its bucket
+    if (timerWheel->isScheduled(entry->NatTimer))
+        timerWheel->cancel(entry->NatTimer);
+    timerWheel->scheduleAt(simTime() + idleTimeout, entry->NatTimer);
+}
 
-    for (SCTPNatEntryTable::iterator i=natEntries.begin(); i!=natEntries.end(); ++i)
+SCTPNatEntry *SCTPNatTable::found(SCTPNatEntry *entry)
+{
+    numLookups++;
+    if (entry)
+        restartIdleTimer(entry);
+    else
+        numLookupMisses++;
+    return entry;
+}
+
+void SCTPNatTable::addNatEntry(SCTPNatEntry* entry)
+{
+    Enter_Method_Silent();
+    natEntries.insert(entry);
+    addToIndex(outboundIndex, EndpointPair(entry->getLocalAddress(), entry->getLocalPort(), entry->getGlobalAddress(), entry->getGlobalPort()), entry);
+    addToIndex(inboundIndex, EndpointPair(entry->getGlobalAddress(), entry->getGlobalPort(), entry->getNattedAddress(), entry->getNattedPort()), entry);
+    addToIndex(localIndex, EndpointPair(entry->getGlobalAddress(), entry->getGlobalPort(), IPvXAddress(), entry->getLocalPort()), entry);
+    numAddedEntries++;
+    emit(natEntriesSignal, (long)natEntries.size());
+
+    if (timerWheel)
     {
-        if ((*i)->getGlobalAddress()==globalAddr && (*i)->getGlobalPort()==globalPrt &&
-                (*i)->getNattedAddress()==nattedAddr && (*i)->getNattedPort()==nattedPrt &&
-                (*i)->getGlobalVTag()==0)
-        {
-            return *i;
-        }
+        entry->NatTimer = new cMessage("natIdleTimer");
+        entry->NatTimer->setContextPointer(entry);
+        restartIdleTimer(entry);
     }
-    return NULL;
+}
+
+SCTPNatEntry* SCTPNatTable::findNatEntry(IPvXAddress srcAddr, uint16 srcPrt, IPvXAddress destAddr, uint16 destPrt, uint32 globalVtag)
+{
+    Enter_Method_Silent();
+    std::pair<SCTPNatEntryIndex::iterator, SCTPNatEntryIndex::iterator> range = outboundIndex.equal_range(EndpointPair(srcAddr, srcPrt, destAddr, destPrt));
+    for (SCTPNatEntryIndex::iterator i=range.first; i!=range.second; ++i)
+        if (i->second->getGlobalVTag()==globalVtag)
+            return found(i->second);
+    return found(NULL);
+}
+
+SCTPNatEntry* SCTPNatTable::getEntry(IPvXAddress globalAddr, uint16 globalPrt, IPvXAddress nattedAddr, uint16 nattedPrt, uint32 localVtag)
+{
+    Enter_Method_Silent();
+    std::pair<SCTPNatEntryIndex::iterator, SCTPNatEntryIndex::iterator> range = inboundIndex.equal_range(EndpointPair(globalAddr, globalPrt, nattedAddr, nattedPrt));
+    for (SCTPNatEntryIndex::iterator i=range.first; i!=range.second; ++i)
+        if (i->second->getLocalVTag()==localVtag)
+            return found(i->second);
+    return found(NULL);
+}
+
+SCTPNatEntry* SCTPNatTable::getSpecialEntry(IPvXAddress globalAddr, uint16 globalPrt, IPvXAddress nattedAddr, uint16 nattedPrt)
+{
+    Enter_Method_Silent();
+    std::pair<SCTPNatEntryIndex::iterator, SCTPNatEntryIndex::iterator> range = inboundIndex.equal_range(EndpointPair(globalAddr, globalPrt, nattedAddr, nattedPrt));
+    for (SCTPNatEntryIndex::iterator i=range.first; i!=range.second; ++i)
+        if (i->second->getGlobalVTag()==0)
+            return found(i->second);
+    return found(NULL);
 }
 
 SCTPNatEntry* SCTPNatTable::getLocalInitEntry(IPvXAddress globalAddr, uint16 localPrt, uint16 globalPrt)
 {
-    // linear search is OK because normally we don't have many interfaces and this func is rarely called
     Enter_Method_Silent();
-    for (SCTPNatEntryTable::iterator i=natEntries.begin(); i!=natEntries.end(); ++i)
-        if ((*i)->getGlobalAddress()==globalAddr && (*i)->getGlobalPort()==localPrt &&
-                (*i)->getLocalPort()==globalPrt)
-        {
-            return *i;
-        }
-    return NULL;
+    std::pair<SCTPNatEntryIndex::iterator, SCTPNatEntryIndex::iterator> range = localIndex.equal_range(EndpointPair(globalAddr, localPrt, IPvXAddress(), globalPrt));
+    return found(range.first != range.second ? range.first->second : NULL);
 }
 
 SCTPNatEntry* SCTPNatTable::getLocalEntry(IPvXAddress globalAddr, uint16 localPrt, uint16 globalPrt, uint32 localVtag)
 {
-    // linear search is OK because normally we don't have many interfaces and this func is rarely called
     Enter_Method_Silent();
-    for (SCTPNatEntryTable::iterator i=natEntries.begin(); i!=natEntries.end(); ++i)
-        if ((*i)->getGlobalAddress()==globalAddr && (*i)->getGlobalPort()==localPrt &&
-                (*i)->getLocalPort()==globalPrt && (*i)->getLocalVTag()==localVtag)
-        {
-            return *i;
-        }
-    return NULL;
+    std::pair<SCTPNatEntryIndex::iterator, SCTPNatEntryIndex::iterator> range = localIndex.equal_range(EndpointPair(globalAddr, localPrt, IPvXAddress(), globalPrt));
+    for (SCTPNatEntryIndex::iterator i=range.first; i!=range.second; ++i)
+        if (i->second->getLocalVTag()==localVtag)
+            return found(i->second);
+    return found(NULL);
 }
 
 void SCTPNatTable::removeEntry(SCTPNatEntry* entry)
 {
     Enter_Method_Silent();
-    for (SCTPNatEntryTable::iterator i=natEntries.begin(); i!=natEntries.end(); ++i)
-        if (((*i)->getGlobalAddress()==entry->getGlobalAddress() && (*i)->getGlobalPort()==entry->getGlobalPort() &&
-                (*i)->getLocalPort()==entry->getLocalPort() && (*i)->getLocalVTag()==entry->getLocalVTag())
-                || (((*i)->getLocalAddress()==entry->getGlobalAddress() && (*i)->getLocalPort()==entry->getGlobalPort() &&
-                        (*i)->getGlobalPort()==entry->getLocalPort() && (*i)->getGlobalVTag()==entry->getLocalVTag())))
-        {
-            natEntries.erase(i);
-            return;
-        }
+    if (natEntries.erase(entry) == 0)
+        return;
+    removeFromIndex(outboundIndex, EndpointPair(entry->getLocalAddress(), entry->getLocalPort(), entry->getGlobalAddress(), entry->getGlobalPort()), entry);
+    removeFromIndex(inboundIndex, EndpointPair(entry->getGlobalAddress(), entry->getGlobalPort(), entry->getNattedAddress(), entry->getNattedPort()), entry);
+    removeFromIndex(localIndex, EndpointPair(entry->getGlobalAddress(), entry->getGlobalPort(), IPvXAddress(), entry->getLocalPort()), entry);
+    if (timerWheel && entry->NatTimer)
+        timerWheel->cancel(entry->NatTimer);
+    delete entry;
+    emit(natEntriesSignal, (long)natEntries.size());
 }
 
 void SCTPNatTable::printNatTable()
@@ -140,6 +227,7 @@ void SCTPNatTable::printNatTable()
 
 SCTPNatEntry::SCTPNatEntry()
 {
+    entryNumber = 0;
     localAddress = IPvXAddress("0.0.0.0");
     globalAddress = IPvXAddress("0.0.0.0");
     nattedAddress = IPvXAddress("0.0.0.0");
@@ -148,9 +236,10 @@ SCTPNatEntry::SCTPNatEntry()
     nattedPort = 0;
     globalVtag = 0;
     localVtag = 0;
+    NatTimer = NULL;
 }
 
 SCTPNatEntry::~SCTPNatEntry()
 {
-
+    delete NatTimer;
 }
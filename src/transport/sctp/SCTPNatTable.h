@@ -19,12 +19,20 @@
 #ifndef __SCTPNATTABLE_H
 #define __SCTPNATTABLE_H
 
-#include <vector>
+#include <map>
+#include <set>
 #include <omnetpp.h>
 #include "IPvXAddress.h"
 #include "SCTPAssociation.h"
 
+class TimerWheel;
 
+
+/**
+ * One association through the NAT. Addresses and ports must not be changed
+ * once the entry has been added to a SCTPNatTable, as they are the keys of
+ * its indices; the verification tags may be updated at any time.
+ */
 class INET_API SCTPNatEntry : public cPolymorphic
 {
   protected:
@@ -42,7 +50,7 @@ class INET_API SCTPNatEntry : public cPolymorphic
     SCTPNatEntry();
     ~SCTPNatEntry();
 
-    cMessage* NatTimer;
+    cMessage* NatTimer;     // idle timer, owned by the SCTPNatTable
     void setLocalAddress(IPvXAddress addr) {localAddress = addr;};
     void setGlobalAddress(IPvXAddress addr) {globalAddress = addr;};
     void setNattedAddress(IPvXAddress addr) {nattedAddress = addr;};
@@ -64,13 +72,57 @@ class INET_API SCTPNatEntry : public cPolymorphic
 };
 
 
+/**
+ * The NAT table of SCTPNatRouter. Entries are indexed by the address/port
+ * pairs of both directions, and the verification tags are compared only
+ * among the (few) entries of the same address/port pair. With a positive
+ * idleTimeout, entries that have not been looked up for that long are
+ * removed; the idle timers are kept in a TimerWheel, so restarting them
+ * on every packet is cheap.
+ */
 class INET_API SCTPNatTable : public cSimpleModule
 {
-  public:
-
-    typedef std::vector<SCTPNatEntry*> SCTPNatEntryTable;
+  protected:
+    struct EndpointPair
+    {
+        IPvXAddress addr1;
+        IPvXAddress addr2;
+        uint16 port1;
+        uint16 port2;
+        EndpointPair(const IPvXAddress& addr1, uint16 port1, const IPvXAddress& addr2, uint16 port2) :
+            addr1(addr1), addr2(addr2), port1(port1), port2(port2) {}
+        bool operator<(const EndpointPair& other) const;
+    };
+
+    typedef std::set<SCTPNatEntry*> SCTPNatEntryTable;
+    typedef std::multimap<EndpointPair, SCTPNatEntry*> SCTPNatEntryIndex;
 
     SCTPNatEntryTable natEntries;
+    SCTPNatEntryIndex outboundIndex;    // (local addr, local port, global addr, global port)
+    SCTPNatEntryIndex inboundIndex;     // (global addr, global port, natted addr, natted port)
+    SCTPNatEntryIndex localIndex;       // (global addr, global port, -, local port), for local delivery
+
+    simtime_t idleTimeout;
+    TimerWheel *timerWheel;
+
+    // statistics
+    static simsignal_t natEntriesSignal;
+    long numLookups;
+    long numLookupMisses;
+    long numAddedEntries;
+    long numExpiredEntries;
+
+  protected:
+    virtual void initialize();
+    virtual void handleMessage(cMessage *msg);
+    virtual void finish();
+
+    SCTPNatEntry *found(SCTPNatEntry *entry);
+    void addToIndex(SCTPNatEntryIndex& index, const EndpointPair& key, SCTPNatEntry *entry);
+    void removeFromIndex(SCTPNatEntryIndex& index, const EndpointPair& key, SCTPNatEntry *entry);
+    void restartIdleTimer(SCTPNatEntry *entry);
+
+  public:
 
     SCTPNatTable();
 
@@ -78,7 +130,10 @@ class INET_API SCTPNatTable : public cSimpleModule
 
     static uint32 nextEntryNumber;
 
-    //void addNatEntry(SCTPNatEntry* entry);
+    /**
+     * Adds the entry to the table, which takes over its ownership.
+     */
+    void addNatEntry(SCTPNatEntry* entry);
 
     SCTPNatEntry* findNatEntry(IPvXAddress srcAddr, uint16 srcPrt, IPvXAddress destAddr, uint16 destPrt, uint32 globalVtag);
 
@@ -90,8 +145,13 @@ class INET_API SCTPNatTable : public cSimpleModule
 
     SCTPNatEntry* getLocalEntry(IPvXAddress globalAddr, uint16 localPrt, uint16 globalPrt, uint32 localVtag);
 
+    /**
+     * Removes the entry from the table and deletes it.
+     */
     void removeEntry(SCTPNatEntry* entry);
 
+    int getNumEntries() const {return natEntries.size();}
+
     void printNatTable();
 
     static uint32 getNextEntryNumber() {return nextEntryNumber++;};
@@ -148,6 +148,30 @@ SCTPDataVariables* SCTPQueue::getChunkFast(const uint32 tsn, bool& firstTime)
 }
 
 
+void SCTPQueue::getChunksInRange(const uint32 firstTSN, const uint32 lastTSN,
+                                 std::vector<SCTPDataVariables*>& chunks) const
+{
+    if (SCTPAssociation::tsnGt(firstTSN, lastTSN)) {
+        return;    // Empty range
+    }
+    PayloadQueue::const_iterator iterator = payloadQueue.lower_bound(firstTSN);
+    if (firstTSN <= lastTSN) {
+        for ( ; (iterator != payloadQueue.end()) && (iterator->first <= lastTSN); iterator++) {
+            chunks.push_back(iterator->second);
+        }
+    }
+    else {
+        // The range wraps around: take the end of the key space first
+        for ( ; iterator != payloadQueue.end(); iterator++) {
+            chunks.push_back(iterator->second);
+        }
+        for (iterator = payloadQueue.begin();
+              (iterator != payloadQueue.end()) && (iterator->first <= lastTSN); iterator++) {
+            chunks.push_back(iterator->second);
+        }
+    }
+}
+
 void SCTPQueue::removeMsg(const uint32 tsn)
 {
     PayloadQueue::iterator iterator = payloadQueue.find(tsn);
@@ -77,6 +77,14 @@ class INET_API SCTPQueue : public cObject
 
     SCTPDataVariables* getChunkFast(const uint32 tsn, bool& firstTime);
 
+    /**
+     * Appends the queued chunks with TSNs from firstTSN to lastTSN (serial
+     * number order, wrap-around allowed) to the given vector. This visits
+     * only the chunks present instead of looking up every TSN of the range.
+     */
+    void getChunksInRange(const uint32 firstTSN, const uint32 lastTSN,
+                          std::vector<SCTPDataVariables*>& chunks) const;
+
     void removeMsg(const uint32 key);
 
     bool deleteMsg(const uint32 tsn);
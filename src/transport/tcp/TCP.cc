@@ -28,6 +28,7 @@
 #include "TCPConnection.h"
 #include "TCPSegment.h"
 #include "TCPCommand_m.h"
+#include "TimerWheel.h"
 
 #ifdef WITH_IPv4
 #include "ICMPMessage_m.h"
@@ -98,6 +99,9 @@ void TCP::initialize(int stage)
 
         recordStatistics = par("recordStats");
 
+        if (par("useTimerWheel").boolValue())
+            timerWheel = new TimerWheel(this, par("timerWheelGranularity"), "tcpTimerWheelTick");
+
         cModule *netw = simulation.getSystemModule();
         testing = netw->hasPar("testing") && netw->par("testing").boolValue();
         logverbose = !testing && netw->hasPar("logverbose") && netw->par("logverbose").boolValue();
@@ -121,6 +125,7 @@ TCP::~TCP()
         delete i->second;
         tcpAppConnMap.erase(i);
     }
+    delete timerWheel;
 }
 
 void TCP::handleMessage(cMessage *msg)
@@ -132,6 +137,16 @@ void TCP::handleMessage(cMessage *msg)
         EV << "TCP is turned off, dropping '" << msg->getName() << "' message\n";
         delete msg;
     }
+    else if (timerWheel && timerWheel->isTick(msg))
+    {
+        while (cMessage *timer = timerWheel->popExpiredTimer())
+        {
+            TCPConnection *conn = (TCPConnection *) timer->getContextPointer();
+            bool ret = conn->processTimer(timer);
+            if (!ret)
+                removeConnection(conn);
+        }
+    }
     else if (msg->isSelfMessage())
     {
         TCPConnection *conn = (TCPConnection *) msg->getContextPointer();
@@ -479,6 +494,39 @@ void TCP::removeConnection(TCPConnection *conn)
 void TCP::finish()
 {
     tcpEV << getFullPath() << ": finishing with " << tcpConnMap.size() << " connections open.\n";
+
+    if (timerWheel)
+    {
+        recordScalar("timer wheel schedules", timerWheel->getNumScheduled());
+        recordScalar("timer wheel lazy reschedules", timerWheel->getNumLazyReschedules());
+        recordScalar("timer wheel ticks", timerWheel->getNumTicks());
+    }
+}
+
+void TCP::scheduleTimerAt(simtime_t t, cMessage *timer)
+{
+    if (timerWheel)
+        timerWheel->scheduleAt(t, timer);
+    else
+        scheduleAt(t, timer);
+}
+
+cMessage *TCP::cancelTimer(cMessage *timer)
+{
+    if (timerWheel)
+        return timerWheel->cancel(timer);
+    else
+        return cancelEvent(timer);
+}
+
+bool TCP::isTimerScheduled(cMessage *timer) const
+{
+    return timerWheel ? timerWheel->isScheduled(timer) : timer->isScheduled();
+}
+
+simtime_t TCP::getTimerArrivalTime(cMessage *timer) const
+{
+    return timerWheel ? timerWheel->getArrivalTime(timer) : timer->getArrivalTime();
 }
 
 TCPSendQueue* TCP::createSendQueue(TCPDataTransferMode transferModeP)
@@ -547,6 +595,8 @@ void TCP::reset()
         delete it->second;
     tcpAppConnMap.clear();
     tcpConnMap.clear();
+    if (timerWheel)
+        timerWheel->clear();
     usedEphemeralPorts.clear();
     lastEphemeralPort = EPHEMERAL_PORTRANGE_START;
 }
@@ -33,6 +33,7 @@ class TCPConnection;
 class TCPSegment;
 class TCPSendQueue;
 class TCPReceiveQueue;
+class TimerWheel;
 
 // macro for normal EV<< logging (Note: deliberately no parens in macro def)
 #define tcpEV (ev.isDisabled()||TCP::testing)?EV:EV
@@ -147,6 +148,8 @@ class INET_API TCP : public cSimpleModule, public ILifecycle
     ushort lastEphemeralPort;
     std::multiset<ushort> usedEphemeralPorts;
 
+    TimerWheel *timerWheel; // connection timers are kept here instead of the FES if non-NULL
+
   protected:
     /** Factory method; may be overriden for customizing TCP */
     virtual TCPConnection *createConnection(int appGateIndex, int connId);
@@ -166,7 +169,7 @@ class INET_API TCP : public cSimpleModule, public ILifecycle
     bool isOperational;     // lifecycle: node is up/down
 
   public:
-    TCP() {}
+    TCP() : timerWheel(NULL) {}
     virtual ~TCP();
 
   protected:
@@ -209,6 +212,14 @@ class INET_API TCP : public cSimpleModule, public ILifecycle
      */
     virtual TCPReceiveQueue* createReceiveQueue(TCPDataTransferMode transferModeP);
 
+    /** @name Connection timers; go into the timer wheel if enabled, otherwise into the FES */
+    //@{
+    virtual void scheduleTimerAt(simtime_t t, cMessage *timer);
+    virtual cMessage *cancelTimer(cMessage *timer);
+    virtual bool isTimerScheduled(cMessage *timer) const;
+    virtual simtime_t getTimerArrivalTime(cMessage *timer) const;
+    //@}
+
     // ILifeCycle:
     virtual bool handleOperationStage(LifecycleOperation *operation, int stage, IDoneCallback *doneCallback);
 
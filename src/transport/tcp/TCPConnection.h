@@ -526,11 +526,14 @@ class INET_API TCPConnection
 
     /** Utility: start a timer */
     void scheduleTimeout(cMessage *msg, simtime_t timeout)
-        {tcpMain->scheduleAt(simTime()+timeout, msg);}
+        {tcpMain->scheduleTimerAt(simTime()+timeout, msg);}
 
   protected:
     /** Utility: cancel a timer */
-    cMessage *cancelEvent(cMessage *msg) {return tcpMain->cancelEvent(msg);}
+    cMessage *cancelEvent(cMessage *msg) {return tcpMain->cancelTimer(msg);}
+
+    /** Utility: returns true if the timer is running */
+    bool isTimerScheduled(cMessage *msg) const {return tcpMain->isTimerScheduled(msg);}
 
     /** Utility: send IP packet */
     static void sendToIP(TCPSegment *tcpseg, IPvXAddress src, IPvXAddress dest);
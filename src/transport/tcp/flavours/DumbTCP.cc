@@ -35,7 +35,7 @@ DumbTCP::~DumbTCP()
 {
     // cancel and delete timers
     if (rexmitTimer)
-        delete conn->getTcpMain()->cancelEvent(rexmitTimer);
+        delete conn->getTcpMain()->cancelTimer(rexmitTimer);
 }
 
 void DumbTCP::initialize()
@@ -60,7 +60,7 @@ void DumbTCP::established(bool active)
 
 void DumbTCP::connectionClosed()
 {
-    conn->getTcpMain()->cancelEvent(rexmitTimer);
+    conn->getTcpMain()->cancelTimer(rexmitTimer);
 }
 
 void DumbTCP::processTimer(cMessage *timer, TCPEventCode& event)
@@ -116,8 +116,8 @@ void DumbTCP::ackSent()
 
 void DumbTCP::dataSent(uint32 fromseq)
 {
-    if (rexmitTimer->isScheduled())
-        conn->getTcpMain()->cancelEvent(rexmitTimer);
+    if (conn->getTcpMain()->isTimerScheduled(rexmitTimer))
+        conn->getTcpMain()->cancelTimer(rexmitTimer);
 
     conn->scheduleTimeout(rexmitTimer, REXMIT_TIMEOUT);
 }
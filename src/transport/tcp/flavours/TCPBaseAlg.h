@@ -150,7 +150,10 @@ class INET_API TCPBaseAlg : public TCPAlgorithm
     virtual bool sendData(bool sendCommandInvoked);
 
     /** Utility function */
-    cMessage *cancelEvent(cMessage *msg) {return conn->getTcpMain()->cancelEvent(msg);}
+    cMessage *cancelEvent(cMessage *msg) {return conn->getTcpMain()->cancelTimer(msg);}
+
+    /** Utility: returns true if the timer is running */
+    bool isTimerScheduled(cMessage *msg) const {return conn->getTcpMain()->isTimerScheduled(msg);}
 
   public:
     /**
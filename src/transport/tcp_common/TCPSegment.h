@@ -21,6 +21,7 @@
 
 #include <list>
 #include "INETDefs.h"
+#include "ObjectPool.h"
 #include "TCPSegment_m.h"
 
 
@@ -57,6 +58,8 @@ class Sack : public Sack_Base
  */
 class INET_API TCPSegment : public TCPSegment_Base
 {
+    INET_POOLED_ALLOCATION(TCPSegment)
+
   protected:
     typedef std::list<TCPPayloadMessage> PayloadList;
     PayloadList payloadList;
@@ -0,0 +1,360 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string.h>
+#include <platdep/timeutil.h>
+
+#include "SimProfiler.h"
+
+#if !defined(_WIN32) && !defined(__WIN32__) && !defined(WIN32) && !defined(__CYGWIN__) && !defined(_WIN64)
+#define HAVE_SIGPROF
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+namespace {
+struct TypeTotals
+{
+    long numInstances;
+    long numEvents;
+    double seconds;
+    long numAllocs;
+    TypeTotals() : numInstances(0), numEvents(0), seconds(0), numAllocs(0) {}
+};
+typedef std::map<std::string, TypeTotals> TypeTotalsMap;
+}
+
+
+Define_Module(SimProfiler);
+
+Register_Class(ProfilingScheduler);
+
+SimProfiler *SimProfiler::instance = NULL;
+
+#ifdef HAVE_SIGPROF
+static struct sigaction oldSigprofAction;
+
+static void blockSigprof(bool block)
+{
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGPROF);
+    sigprocmask(block ? SIG_BLOCK : SIG_UNBLOCK, &set, NULL);
+}
+#endif
+
+SimProfiler::SimProfiler()
+{
+    exactMode = false;
+    samplingInterval = 0;
+    samplingActive = false;
+    schedulerAttached = false;
+    lostSamples = 0;
+    inEvent = false;
+    eventModuleId = 0;
+    eventStartUsecs = 0;
+    eventStartMessageCount = 0;
+    schedulerStartUsecs = 0;
+}
+
+SimProfiler::~SimProfiler()
+{
+    stopSampling();
+    if (instance == this)
+        instance = NULL;
+}
+
+void SimProfiler::initialize()
+{
+    if (!par("enabled").boolValue())
+        return;
+
+    if (instance != NULL && instance != this)
+        throw cRuntimeError("There can be only one SimProfiler module in the network");
+
+    const char *mode = par("mode");
+    if (!strcmp(mode, "exact"))
+        exactMode = true;
+    else if (!strcmp(mode, "sampling"))
+        exactMode = false;
+    else
+        throw cRuntimeError("Invalid mode \"%s\", must be \"sampling\" or \"exact\"", mode);
+
+    schedulerAttached = dynamic_cast<ProfilingScheduler *>(simulation.getScheduler()) != NULL;
+    if (exactMode && !schedulerAttached)
+        throw cRuntimeError("Exact mode requires scheduler-class = \"ProfilingScheduler\" in the configuration");
+
+    ensureSlots(simulation.getLastModuleId());
+    instance = this;
+    schedulerStartUsecs = getWallClockUsecs();
+
+    simulation.getSystemModule()->subscribe(POST_MODEL_CHANGE, this);
+    simulation.getSystemModule()->subscribe(PRE_MODEL_CHANGE, this);
+
+    if (!exactMode) {
+        samplingInterval = par("samplingInterval").doubleValue();
+        if (samplingInterval <= 0)
+            throw cRuntimeError("samplingInterval must be positive");
+        startSampling();
+    }
+}
+
+void SimProfiler::handleMessage(cMessage *msg)
+{
+    throw cRuntimeError("This module does not handle messages");
+}
+
+void SimProfiler::finish()
+{
+    if (instance != this)
+        return;
+
+    if (inEvent)
+        eventEnded();
+    stopSampling();
+    instance = NULL;
+
+    writeFoldedStacks(par("filename"));
+    recordTypeSummary();
+}
+
+void SimProfiler::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj)
+{
+    if (signalID == POST_MODEL_CHANGE) {
+        cPostModuleAddNotification *notification = dynamic_cast<cPostModuleAddNotification *>(obj);
+        if (notification)
+            ensureSlots(notification->module->getId());
+    }
+    else if (signalID == PRE_MODEL_CHANGE) {
+        cPreModuleDeleteNotification *notification = dynamic_cast<cPreModuleDeleteNotification *>(obj);
+        if (notification) {
+            // remember the names, the module id cannot be resolved at finish() any more
+            cModule *mod = notification->module;
+            ensureSlots(mod->getId());
+            ModuleStats& s = stats[mod->getId()];
+            s.fullPath = mod->getFullPath();
+            s.typeName = mod->getNedTypeName();
+        }
+    }
+}
+
+void SimProfiler::ensureSlots(int moduleId)
+{
+    if (moduleId < (int)stats.size())
+        return;
+
+    size_t newSize = std::max((size_t)moduleId + 1, 2 * stats.size());
+    stats.resize(newSize);
+    if (!exactMode) {
+#ifdef HAVE_SIGPROF
+        blockSigprof(true);
+        sampleCounts.resize(newSize, 0);
+        blockSigprof(false);
+#else
+        sampleCounts.resize(newSize, 0);
+#endif
+    }
+}
+
+void SimProfiler::eventStarted(cMessage *msg)
+{
+    int moduleId = msg->getArrivalModuleId();
+    if (moduleId < 0)
+        moduleId = 0;
+    ensureSlots(moduleId);
+
+    if (exactMode) {
+        eventStartUsecs = getWallClockUsecs();
+        stats[0].usecs += eventStartUsecs - schedulerStartUsecs;
+    }
+    inEvent = true;
+    eventModuleId = moduleId;
+    eventStartMessageCount = cMessage::getTotalMessageCount();
+    stats[moduleId].numEvents++;
+}
+
+void SimProfiler::eventEnded()
+{
+    if (!inEvent)
+        return;
+
+    ModuleStats& s = stats[eventModuleId];
+    s.numAllocs += cMessage::getTotalMessageCount() - eventStartMessageCount;
+    if (exactMode) {
+        schedulerStartUsecs = getWallClockUsecs();
+        s.usecs += schedulerStartUsecs - eventStartUsecs;
+    }
+    inEvent = false;
+}
+
+void SimProfiler::samplingTick(int signum)
+{
+    // runs in signal context: only touch preallocated counters
+    SimProfiler *profiler = instance;
+    if (!profiler)
+        return;
+    cModule *mod = simulation.getContextModule();
+    int moduleId = mod ? mod->getId() : 0;
+    if (moduleId >= 0 && moduleId < (int)profiler->sampleCounts.size())
+        profiler->sampleCounts[moduleId]++;
+    else
+        profiler->lostSamples++;
+}
+
+void SimProfiler::startSampling()
+{
+#ifdef HAVE_SIGPROF
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = samplingTick;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    if (sigaction(SIGPROF, &action, &oldSigprofAction) != 0)
+        throw cRuntimeError("Cannot install SIGPROF handler");
+
+    long usecs = std::max(1L, (long)(samplingInterval * 1000000));
+    struct itimerval timer;
+    timer.it_interval.tv_sec = usecs / 1000000;
+    timer.it_interval.tv_usec = usecs % 1000000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, NULL) != 0) {
+        sigaction(SIGPROF, &oldSigprofAction, NULL);
+        throw cRuntimeError("Cannot start profiling timer");
+    }
+    samplingActive = true;
+#else
+    throw cRuntimeError("Sampling mode is not supported on this platform, use mode=\"exact\"");
+#endif
+}
+
+void SimProfiler::stopSampling()
+{
+    if (!samplingActive)
+        return;
+#ifdef HAVE_SIGPROF
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, NULL);
+    sigaction(SIGPROF, &oldSigprofAction, NULL);
+#endif
+    samplingActive = false;
+}
+
+std::string SimProfiler::getModulePath(int moduleId)
+{
+    if (moduleId == 0)
+        return "<scheduler>";
+    cModule *mod = simulation.getModule(moduleId);
+    if (mod)
+        return mod->getFullPath();
+    if (moduleId < (int)stats.size() && !stats[moduleId].fullPath.empty())
+        return stats[moduleId].fullPath;
+    return "<deleted>";
+}
+
+std::string SimProfiler::getModuleTypeName(int moduleId)
+{
+    if (moduleId == 0)
+        return "<scheduler>";
+    cModule *mod = simulation.getModule(moduleId);
+    if (mod)
+        return mod->getNedTypeName();
+    if (moduleId < (int)stats.size() && !stats[moduleId].typeName.empty())
+        return stats[moduleId].typeName;
+    return "<deleted>";
+}
+
+void SimProfiler::writeFoldedStacks(const char *filename)
+{
+    std::ofstream f(filename, std::ios::out | std::ios::trunc);
+    if (f.fail())
+        throw cRuntimeError("Cannot open file \"%s\" for writing", filename);
+
+    for (int id = 0; id < (int)stats.size(); id++) {
+        int64 value = exactMode ? stats[id].usecs : sampleCounts[id];
+        if (value == 0)
+            continue;
+
+        // one frame per level of the module hierarchy
+        std::string frames = getModulePath(id);
+        for (std::string::iterator it = frames.begin(); it != frames.end(); ++it)
+            if (*it == '.')
+                *it = ';';
+        f << frames << " " << value << "\n";
+    }
+
+    f.close();
+    if (f.fail())
+        throw cRuntimeError("Error writing file \"%s\"", filename);
+}
+
+void SimProfiler::recordTypeSummary()
+{
+    TypeTotalsMap totals;
+
+    for (int id = 0; id < (int)stats.size(); id++) {
+        const ModuleStats& s = stats[id];
+        double seconds = exactMode ? s.usecs / 1e6 : sampleCounts[id] * samplingInterval;
+        if (s.numEvents == 0 && seconds == 0)
+            continue;
+        TypeTotals& t = totals[getModuleTypeName(id)];
+        t.numInstances++;
+        t.numEvents += s.numEvents;
+        t.seconds += seconds;
+        t.numAllocs += s.numAllocs;
+    }
+
+    for (TypeTotalsMap::iterator it = totals.begin(); it != totals.end(); ++it) {
+        const std::string& type = it->first;
+        const TypeTotals& t = it->second;
+        recordScalar((type + " instances").c_str(), t.numInstances);
+        recordScalar((type + " time").c_str(), t.seconds, "s");
+        if (schedulerAttached) {
+            recordScalar((type + " events").c_str(), t.numEvents);
+            recordScalar((type + " messages created").c_str(), t.numAllocs);
+        }
+        EV << type << ": " << t.numInstances << " instances, " << t.seconds << "s";
+        if (schedulerAttached)
+            EV << ", " << t.numEvents << " events, " << t.numAllocs << " messages created";
+        EV << endl;
+    }
+    if (!exactMode)
+        recordScalar("lost samples", lostSamples);
+}
+
+int64 SimProfiler::getWallClockUsecs()
+{
+    timeval now;
+    gettimeofday(&now, NULL);
+    return (int64)now.tv_sec * 1000000 + now.tv_usec;
+}
+
+
+cMessage *ProfilingScheduler::getNextEvent()
+{
+    SimProfiler *profiler = SimProfiler::getInstance();
+    if (profiler)
+        profiler->eventEnded();
+    cMessage *msg = cSequentialScheduler::getNextEvent();
+    if (profiler && msg)
+        profiler->eventStarted(msg);
+    return msg;
+}
+
@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2026 INET Framework contributors
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __INET_SIMPROFILER_H
+#define __INET_SIMPROFILER_H
+
+#include <vector>
+#include "INETDefs.h"
+
+
+/**
+ * Records per-module event counts, wall-clock time and message allocations.
+ * See NED file for more information.
+ */
+class INET_API SimProfiler : public cSimpleModule, protected cListener
+{
+  protected:
+    struct ModuleStats
+    {
+        long numEvents;         // events delivered to the module (needs ProfilingScheduler)
+        int64 usecs;            // exact mode: wall time spent processing these events
+        long numAllocs;         // messages created while processing these events
+        std::string fullPath;   // filled in when the module is deleted
+        std::string typeName;
+        ModuleStats() : numEvents(0), usecs(0), numAllocs(0) {}
+    };
+
+    static SimProfiler *instance;
+
+    bool exactMode;
+    double samplingInterval;
+    bool samplingActive;
+    bool schedulerAttached;
+
+    // indexed by module id; slot 0 collects everything outside module context
+    std::vector<ModuleStats> stats;
+
+    // sampling mode: incremented from the SIGPROF handler, so it is only
+    // resized with the signal blocked
+    std::vector<long> sampleCounts;
+    long lostSamples;
+
+    // the event currently being processed
+    bool inEvent;
+    int eventModuleId;
+    int64 eventStartUsecs;
+    long eventStartMessageCount;
+    int64 schedulerStartUsecs;
+
+  protected:
+    virtual void initialize();
+    virtual void handleMessage(cMessage *msg);
+    virtual void finish();
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj);
+
+    virtual void ensureSlots(int moduleId);
+    virtual void startSampling();
+    virtual void stopSampling();
+    virtual void writeFoldedStacks(const char *filename);
+    virtual void recordTypeSummary();
+    virtual std::string getModulePath(int moduleId);
+    virtual std::string getModuleTypeName(int moduleId);
+    static int64 getWallClockUsecs();
+    static void samplingTick(int signum);
+
+  public:
+    SimProfiler();
+    virtual ~SimProfiler();
+
+    /** Returns the active profiler, or NULL if there is none in the network */
+    static SimProfiler *getInstance() { return instance; }
+
+    /** Called by ProfilingScheduler before the given event is delivered */
+    virtual void eventStarted(cMessage *msg);
+
+    /** Called by ProfilingScheduler when the previous event has been processed */
+    virtual void eventEnded();
+};
+
+
+/**
+ * Sequential scheduler that reports event boundaries to SimProfiler.
+ * Select it with <tt>scheduler-class = "ProfilingScheduler"</tt> in omnetpp.ini;
+ * it behaves like the default scheduler when there is no SimProfiler in the network.
+ */
+class INET_API ProfilingScheduler : public cSequentialScheduler
+{
+  public:
+    ProfilingScheduler() {}
+    virtual cMessage *getNextEvent();
+};
+
+#endif  // header guard
+
@@ -16,29 +16,120 @@
 // along with this program; if not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <string.h>
+
 #include "TCPIPchecksum.h"
 
 //#if !defined(_WIN32) && !defined(__WIN32__) && !defined(WIN32) && !defined(__CYGWIN__) && !defined(_WIN64)
 //#include <netinet/in.h>  // htonl, ntohl, ...
 //#endif
 
+// The one's complement sum does not depend on the byte order (RFC 1071), and
+// 2^16 = 1 in one's complement arithmetic, so pairs of 16 bit words can be
+// added as 32 bit words into a 64 bit accumulator without carry checks, and
+// folded at the end. Four independent accumulators let the compiler overlap
+// (or vectorize) the additions.
+
+static inline uint16_t fold(uint64_t sum)
+{
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    while (sum >> 16)
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    return (uint16_t)sum;
+}
+
 uint16_t TCPIPchecksum::_checksum(const void *addr, unsigned int count)
 {
-    uint32_t sum = 0;
+    const uint8_t *p = (const uint8_t *)addr;
+    uint64_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+    uint32_t w0, w1, w2, w3;
 
-    while (count > 1)
+    while (count >= 16)
     {
-        sum += *((const uint16_t *&)addr)++;
-        if (sum & 0x80000000)
-            sum = (sum & 0xFFFF) + (sum >> 16);
+        memcpy(&w0, p, 4);
+        memcpy(&w1, p + 4, 4);
+        memcpy(&w2, p + 8, 4);
+        memcpy(&w3, p + 12, 4);
+        sum0 += w0;
+        sum1 += w1;
+        sum2 += w2;
+        sum3 += w3;
+        p += 16;
+        count -= 16;
+    }
+
+    uint64_t sum = sum0 + sum1 + sum2 + sum3;
+    while (count >= 4)
+    {
+        memcpy(&w0, p, 4);
+        sum += w0;
+        p += 4;
+        count -= 4;
+    }
+
+    if (count >= 2)
+    {
+        uint16_t w;
+        memcpy(&w, p, 2);
+        sum += w;
+        p += 2;
         count -= 2;
     }
 
     if (count)
-        sum += *(const uint8_t *)addr;
+        sum += *p;
 
-    while (sum >> 16)
-        sum = (sum & 0xFFFF) + (sum >> 16);
+    return fold(sum);
+}
 
-    return (uint16_t)sum;
+uint16_t TCPIPchecksum::_checksumAndCopy(void *dest, const void *src, unsigned int count)
+{
+    const uint8_t *s = (const uint8_t *)src;
+    uint8_t *d = (uint8_t *)dest;
+    uint64_t sum0 = 0, sum1 = 0;
+    uint32_t w0, w1;
+
+    while (count >= 8)
+    {
+        memcpy(&w0, s, 4);
+        memcpy(&w1, s + 4, 4);
+        memcpy(d, &w0, 4);
+        memcpy(d + 4, &w1, 4);
+        sum0 += w0;
+        sum1 += w1;
+        s += 8;
+        d += 8;
+        count -= 8;
+    }
+
+    uint64_t sum = sum0 + sum1;
+    if (count >= 4)
+    {
+        memcpy(&w0, s, 4);
+        memcpy(d, &w0, 4);
+        sum += w0;
+        s += 4;
+        d += 4;
+        count -= 4;
+    }
+
+    if (count >= 2)
+    {
+        uint16_t w;
+        memcpy(&w, s, 2);
+        memcpy(d, &w, 2);
+        sum += w;
+        s += 2;
+        d += 2;
+        count -= 2;
+    }
+
+    if (count)
+    {
+        *d = *s;
+        sum += *s;
+    }
+
+    return fold(sum);
 }
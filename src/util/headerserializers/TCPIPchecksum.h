@@ -42,7 +42,50 @@ class TCPIPchecksum
             return ~ _checksum(addr, count);
         }
 
+        /*
+         * returns the one's complement sum of the 16 bit words (not yet
+         * complemented); sums of ranges that start at even offsets can be
+         * combined with add()
+         */
         static uint16_t _checksum(const void *addr, unsigned int count);
+
+        /*
+         * like _checksum(), but also copies the count bytes from src to dest
+         * in the same pass; the ranges must not overlap
+         */
+        static uint16_t _checksumAndCopy(void *dest, const void *src, unsigned int count);
+
+        /*
+         * one's complement addition of two sums returned by _checksum()
+         */
+        static uint16_t add(uint16_t sum1, uint16_t sum2)
+        {
+            uint32_t sum = (uint32_t)sum1 + sum2;
+            return (uint16_t)((sum & 0xFFFF) + (sum >> 16));
+        }
+
+        /*
+         * incremental update of a checksum field after a 16 bit word of the
+         * checksummed data changed from oldWord to newWord (RFC 1624, eqn. 3),
+         * e.g. after decrementing the TTL; all values as stored in the packet
+         */
+        static uint16_t update(uint16_t checksum, uint16_t oldWord, uint16_t newWord)
+        {
+            uint32_t sum = (uint16_t)~checksum + (uint32_t)(uint16_t)~oldWord + newWord;
+            sum = (sum & 0xFFFF) + (sum >> 16);
+            sum = (sum & 0xFFFF) + (sum >> 16);
+            return (uint16_t)~sum;
+        }
+
+        /*
+         * the same for a 32 bit field, e.g. an address rewritten by NAT
+         */
+        static uint16_t update32(uint16_t checksum, uint32_t oldValue, uint32_t newValue)
+        {
+            // the halves of the same bytes are paired either way, so the byte order doesn't matter
+            checksum = update(checksum, (uint16_t)(oldValue & 0xFFFF), (uint16_t)(newValue & 0xFFFF));
+            return update(checksum, (uint16_t)(oldValue >> 16), (uint16_t)(newValue >> 16));
+        }
 };
 
 #endif
@@ -44,6 +44,12 @@ using namespace INETFw;
 
 int TCPSerializer::serialize(const TCPSegment *tcpseg,
         unsigned char *buf, unsigned int bufsize)
+{
+    return serialize(tcpseg, buf, bufsize, NULL);
+}
+
+int TCPSerializer::serialize(const TCPSegment *tcpseg,
+        unsigned char *buf, unsigned int bufsize, uint16_t *sum)
 {
     ASSERT(buf);
     ASSERT(tcpseg);
@@ -123,18 +129,42 @@ int TCPSerializer::serialize(const TCPSegment *tcpseg,
     } // if options present
 
     // write data
+    unsigned int dataOffset = TCP_HEADER_OCTETS + lengthCounter;  // even, as options are padded
+    unsigned int dataLength = 0;
+    uint16_t dataSum = 0;
     if (tcpseg->getByteLength() > tcpseg->getHeaderLength()) // data present? FIXME TODO: || tcpseg->getEncapsulatedPacket()!=NULL
     {
-        unsigned int dataLength = tcpseg->getByteLength() - tcpseg->getHeaderLength();
+        dataLength = tcpseg->getByteLength() - tcpseg->getHeaderLength();
         char *tcpData = (char *)options+lengthCounter;
 
         if (tcpseg->getByteArray().getDataArraySize() > 0)
         {
             ASSERT(tcpseg->getByteArray().getDataArraySize() == dataLength);
-            tcpseg->getByteArray().copyDataToBuffer(tcpData, dataLength);
+            if (sum)
+                dataSum = TCPIPchecksum::_checksumAndCopy(tcpData, tcpseg->getByteArray().getDataPointer(), dataLength);
+            else
+                tcpseg->getByteArray().copyDataToBuffer(tcpData, dataLength);
         }
         else
+        {
             memset(tcpData, 't', dataLength); // fill data part with 't'
+            if (sum)
+            {
+                // every 16 bit word is 0x7474 in either byte order, an odd last byte counts as itself
+                uint64_t fillSum = (uint64_t)(dataLength / 2) * 0x7474 + ((dataLength & 1) ? 't' : 0);
+                while (fillSum >> 16)
+                    fillSum = (fillSum & 0xFFFF) + (fillSum >> 16);
+                dataSum = (uint16_t)fillSum;
+            }
+        }
+    }
+
+    if (sum)
+    {
+        if (dataOffset + dataLength == (unsigned int)writtenbytes)
+            *sum = TCPIPchecksum::add(TCPIPchecksum::_checksum(buf, dataOffset), dataSum);
+        else
+            *sum = TCPIPchecksum::_checksum(buf, writtenbytes);  // header length field disagrees with the options
     }
     return writtenbytes;
 }
@@ -143,9 +173,10 @@ int TCPSerializer::serialize(const TCPSegment *tcpseg,
         unsigned char *buf, unsigned int bufsize,
         const IPvXAddress &srcIp, const IPvXAddress &destIp)
 {
-    int writtenbytes = serialize(tcpseg, buf, bufsize);
+    uint16_t sum;
+    int writtenbytes = serialize(tcpseg, buf, bufsize, &sum);
     struct tcphdr *tcp = (struct tcphdr*) (buf);
-    tcp->th_sum = checksum(tcp, writtenbytes, srcIp, destIp);
+    tcp->th_sum = checksum(sum, writtenbytes, srcIp, destIp);
 
     return writtenbytes;
 }
@@ -237,7 +268,13 @@ void TCPSerializer::parse(const unsigned char *buf, unsigned int bufsize, TCPSeg
 uint16_t TCPSerializer::checksum(const void *addr, unsigned int count,
         const IPvXAddress &srcIp, const IPvXAddress &destIp)
 {
-    uint32_t sum = TCPIPchecksum::_checksum(addr, count);
+    return checksum(TCPIPchecksum::_checksum(addr, count), count, srcIp, destIp);
+}
+
+uint16_t TCPSerializer::checksum(uint16_t dataSum, unsigned int count,
+        const IPvXAddress &srcIp, const IPvXAddress &destIp)
+{
+    uint32_t sum = dataSum;
 
     ASSERT(srcIp.wordCount() == destIp.wordCount());
 
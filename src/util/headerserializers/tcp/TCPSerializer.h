@@ -34,6 +34,20 @@ class TCPSegment;
  */
 class TCPSerializer
 {
+    protected:
+        /**
+         * Implements serialize(). If sum is not NULL, it is set to the
+         * one's complement sum of the written bytes (see TCPIPchecksum),
+         * computed while writing the payload instead of in a second pass.
+         */
+        int serialize(const TCPSegment *source, unsigned char *destbuf, unsigned int bufsize, uint16_t *sum);
+
+        /**
+         * Completes the checksum of count bytes whose sum is given with the pseudo header.
+         */
+        static uint16_t checksum(uint16_t sum, unsigned int count,
+                const IPvXAddress &srcIp, const IPvXAddress &destIp);
+
     public:
         TCPSerializer() {}
 
@@ -71,7 +71,7 @@ class RIPPacket;
 #endif
 
 #ifdef WITH_RADIO
-#include "AirFrame_m.h"
+#include "AirFrame.h"
 #else
 class AirFrame;
 #endif
@@ -19,7 +19,7 @@
 #include "ChannelAccess.h"
 #include "IMobility.h"
 
-#define coreEV (ev.isDisabled()||!coreDebug) ? EV : EV << logName() << "::ChannelAccess: "
+#define coreEV EV_LOG_IF(INET_LOGLEVEL_DEBUG, coreDebug) << logName() << "::ChannelAccess: "
 
 simsignal_t ChannelAccess::mobilityStateChangedSignal = registerSignal("mobilityStateChanged");
 
@@ -19,9 +19,10 @@
 #include "FWMath.h"
 #include <cassert>
 
-#include "AirFrame_m.h"
+#include "AirFrame.h"
+#include "IReceptionModel.h"
 
-#define coreEV (ev.isDisabled()||!coreDebug) ? EV : EV << "ChannelControl: "
+#define coreEV EV_LOG_IF(INET_LOGLEVEL_DEBUG, coreDebug) << "ChannelControl: "
 
 Define_Module(ChannelControl);
 
@@ -69,6 +70,13 @@ void ChannelControl::initialize()
 
     maxInterferenceDistance = calcInterfDist();
 
+    cullBySendPower = par("cullBySendPower");
+    cullByReceivedPower = par("cullByReceivedPower");
+    cullingThreshold = FWMath::dBm2mW(par("cullingThreshold"));
+    alpha = par("alpha");
+    carrierFrequency = par("carrierFrequency");
+    numCulledDeliveries = 0;
+    WATCH(numCulledDeliveries);
     WATCH(maxInterferenceDistance);
     WATCH_LIST(radios);
     WATCH_VECTOR(transmissions);
@@ -124,6 +132,7 @@ ChannelControl::RadioRef ChannelControl::registerRadio(cModule *radio, cGate *ra
     re.radioInGate = radioInGate->getPathStartGate();
     re.isNeighborListValid = false;
     re.channel = 0;  // for now
+    re.receptionModel = NULL;
     re.isActive = true;
     radios.push_back(re);
     return &radios.back(); // last element
@@ -287,6 +296,45 @@ void ChannelControl::purgeOngoingTransmissions()
     }
 }
 
+double ChannelControl::calcCullingDistance(double pSend, double carrierFrequency)
+{
+    // same free space formula as calcInterfDist(), with the frame's own power
+    double waveLength = (SPEED_OF_LIGHT / carrierFrequency);
+    return pow(waveLength * waveLength * pSend /
+               (16.0 * M_PI * M_PI * cullingThreshold), 1.0 / alpha);
+}
+
+void ChannelControl::calculateDistances(const Coord& pos, const RadioRefVector& radios)
+{
+    int n = radios.size();
+    receiverX.resize(n);
+    receiverY.resize(n);
+    receiverZ.resize(n);
+    receiverDistance.resize(n);
+    for (int i = 0; i < n; i++)
+    {
+        const Coord& p = radios[i]->pos;
+        receiverX[i] = p.x;
+        receiverY[i] = p.y;
+        receiverZ[i] = p.z;
+    }
+
+    // same arithmetic as Coord::distance(), but in a loop the compiler can vectorize
+    if (n == 0)
+        return;
+    const double *x = &receiverX[0];
+    const double *y = &receiverY[0];
+    const double *z = &receiverZ[0];
+    double *d = &receiverDistance[0];
+    for (int i = 0; i < n; i++)
+    {
+        double dx = pos.x - x[i];
+        double dy = pos.y - y[i];
+        double dz = pos.z - z[i];
+        d[i] = sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
+
 void ChannelControl::sendToChannel(RadioRef srcRadio, AirFrame *airFrame)
 {
     // NOTE: no Enter_Method()! We pretend this method is part of ChannelAccess
@@ -295,6 +343,18 @@ void ChannelControl::sendToChannel(RadioRef srcRadio, AirFrame *airFrame)
     const RadioRefVector& neighbors = getNeighbors(srcRadio);
     int n = neighbors.size();
     int channel = airFrame->getChannelNumber();
+    calculateDistances(srcRadio->pos, neighbors);
+    double frequency = airFrame->getCarrierFrequency() > 0 ? airFrame->getCarrierFrequency() : carrierFrequency;
+    double cullingDistance = maxInterferenceDistance;
+    if (cullBySendPower && airFrame->getPSend() > 0)
+        cullingDistance = calcCullingDistance(airFrame->getPSend(), frequency);
+    bool cullByPower = cullByReceivedPower && srcRadio->receptionModel && n > 0;
+    if (cullByPower)
+    {
+        // all receivers at once; assumes the receivers use the same reception model and antenna gains as the sender
+        receivedPower.resize(n);
+        srcRadio->receptionModel->calculateReceivedPowers(airFrame->getPSend(), frequency, &receiverDistance[0], &receivedPower[0], n);
+    }
     for (int i=0; i<n; i++)
     {
         RadioRef r = neighbors[i];
@@ -303,12 +363,24 @@ void ChannelControl::sendToChannel(RadioRef srcRadio, AirFrame *airFrame)
             coreEV << "skipping disabled radio interface \n";
             continue;
         }
+        if (cullBySendPower && receiverDistance[i] > cullingDistance)
+        {
+            coreEV << "skipping radio beyond the range of the actual transmission power\n";
+            numCulledDeliveries++;
+            continue;
+        }
+        if (cullByPower && receivedPower[i] < cullingThreshold)
+        {
+            coreEV << "skipping radio where the frame arrives below cullingThreshold\n";
+            numCulledDeliveries++;
+            continue;
+        }
         if (r->channel == channel)
         {
             coreEV << "sending message to radio listening on the same channel\n";
             // account for propagation delay, based on distance in meters
             // Over 300m, dt=1us=10 bit times @ 10Mbps
-            simtime_t delay = srcRadio->pos.distance(r->pos) / SPEED_OF_LIGHT;
+            simtime_t delay = receiverDistance[i] / SPEED_OF_LIGHT;
             check_and_cast<cSimpleModule*>(srcRadio->radioModule)->sendDirect(airFrame->dup(), delay, airFrame->getDuration(), r->radioInGate);
         }
         else
@@ -40,6 +40,7 @@ struct IChannelControl::RadioEntry {
     cGate *radioInGate;  // gate on host module used to receive airframes
     int channel;
     Coord pos; // cached radio position
+    IReceptionModel *receptionModel; // owned by the radio; NULL unless deterministic
 
     struct Compare {
         bool operator() (const RadioRef &lhs, const RadioRef &rhs) const {
@@ -91,6 +92,25 @@ class INET_API ChannelControl : public cSimpleModule, public IChannelControl
     /** the number of controlled channels */
     int numChannels;
 
+    /** skip receivers beyond the interference range of the frame's actual transmission power */
+    bool cullBySendPower;
+    /** received power (in mW) below which a receiver is skipped when cullBySendPower is set */
+    double cullingThreshold;
+    /** path loss coefficient, carrier frequency used when the frame does not carry one */
+    double alpha;
+    double carrierFrequency;
+    /** skip receivers where the sender's reception model puts the frame below cullingThreshold */
+    bool cullByReceivedPower;
+    /** number of deliveries skipped by cullBySendPower or cullByReceivedPower */
+    long numCulledDeliveries;
+
+    /** scratch arrays for sendToChannel(): neighbor positions and distances, as structure of arrays */
+    std::vector<double> receiverX;
+    std::vector<double> receiverY;
+    std::vector<double> receiverZ;
+    std::vector<double> receiverDistance;
+    std::vector<double> receivedPower;
+
   protected:
     virtual void updateConnections(RadioRef h);
 
@@ -109,6 +129,12 @@ class INET_API ChannelControl : public cSimpleModule, public IChannelControl
     /** Get the list of modules in range of the given host */
     virtual const RadioRefVector& getNeighbors(RadioRef h);
 
+    /** Returns the distance beyond which a frame sent with the given power is received below cullingThreshold */
+    virtual double calcCullingDistance(double pSend, double carrierFrequency);
+
+    /** Fills receiverDistance with the distances of the given radios from pos */
+    virtual void calculateDistances(const Coord& pos, const RadioRefVector& radios);
+
     /** Notifies the channel control with an ongoing transmission */
     virtual void addOngoingTransmission(RadioRef h, AirFrame *frame);
 
@@ -140,6 +166,9 @@ class INET_API ChannelControl : public cSimpleModule, public IChannelControl
     /** Called when host switches channel */
     virtual void setRadioChannel(RadioRef r, int channel);
 
+    /** Sets the deterministic reception model of the given radio, used by cullByReceivedPower */
+    virtual void setRadioReceptionModel(RadioRef r, IReceptionModel *receptionModel) { r->receptionModel = receptionModel; }
+
     /** Returns the number of radio channels (frequencies) simulated */
     virtual int getNumChannels() { return numChannels; }
 